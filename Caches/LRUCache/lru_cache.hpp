@@ -0,0 +1,269 @@
+/// Copyright [2018] <João Fellipe Uller>
+#ifndef STRUCTURES_LRU_CACHE_H
+#define STRUCTURES_LRU_CACHE_H
+
+#include <cstdint>
+#include <functional>  // std::hash
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "doubly_circular_list.hpp"
+
+namespace structures {
+
+template<typename K, typename V, typename Hash = std::hash<K>,
+         template<typename> class Allocator = NewAllocator>
+/// Cache LRU (least recently used) de capacidade fixa
+///
+/// As entradas ficam numa lista duplamente encadeada circular, da mais
+/// recente (inicio) para a menos recente (fim): promover e descartar sao
+/// O(1). Um indice hash de enderecamento aberto (sondagem linear, remocao
+/// por deslocamento para tras) leva da chave ao nodo da lista em O(1)
+/// esperado. K e V devem ter construtor padrao (nodo sentinela da lista).
+class LRUCache {
+ public:
+    /// Cache com ate capacity entradas
+    explicit LRUCache(std::size_t capacity);
+
+    LRUCache(const LRUCache&) = delete;
+    LRUCache& operator=(const LRUCache&) = delete;
+
+    /// valor da chave, promovido a mais recente; nullptr se ausente.
+    /// O ponteiro vale ate a proxima insercao ou remocao
+    V* get(const K& key);
+
+    /// insere ou atualiza a chave como mais recente, descartando a menos
+    /// recente se o cache estiver cheio; retorna se a chave era nova
+    bool put(const K& key, const V& value);
+
+    /// remove a chave; retorna se ela estava no cache
+    bool erase(const K& key);
+
+    /// contem a chave (sem alterar a ordem de uso nem os contadores)
+    bool contains(const K& key) const;
+
+    /// limpar
+    void clear();
+
+    /// cache vazio
+    bool empty() const;
+
+    /// numero de entradas
+    std::size_t size() const;
+
+    /// numero maximo de entradas
+    std::size_t capacity() const;
+
+    /// acertos e falhas de get()
+    std::size_t hits() const;
+    std::size_t misses() const;
+
+    /// zera os contadores de acertos e falhas
+    void reset_stats();
+
+ private:
+    typedef DoublyCircularList<std::pair<K, V>, Allocator> List;
+    typedef typename List::iterator Entry;
+
+    struct Slot {  /// Posicao do indice: vazia se entry == Entry{}
+        std::size_t hash;
+        Entry entry;
+    };
+
+    /// Espalha os bits do hash (std::hash de inteiros e' a identidade)
+    static std::size_t mix(std::size_t hash);
+
+    /// Posicao da chave no indice, ou a posicao vazia onde ela entraria
+    std::size_t find_slot(const K& key, std::size_t hash) const;
+
+    /// Esvazia a posicao, deslocando para tras as chaves seguintes
+    void erase_slot(std::size_t slot);
+
+    List entries_;  // da mais recente para a menos recente
+    std::vector<Slot> index_;
+    std::size_t mask_;
+    std::size_t capacity_;
+    std::size_t hits_{0u};
+    std::size_t misses_{0u};
+    Hash hasher_;
+};
+
+}  // namespace structures
+
+#endif
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+structures::LRUCache<K, V, Hash, Allocator>::LRUCache(std::size_t capacity):
+    capacity_{capacity}
+{
+    if (capacity == 0)
+        throw std::invalid_argument("Invalid capacity!");
+
+    /// Fator de carga de no maximo 1/2
+    std::size_t slots = 2;
+    while (slots < 2 * capacity)
+        slots *= 2;
+    index_.assign(slots, Slot{0u, Entry{}});
+    mask_ = slots - 1;
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+V* structures::LRUCache<K, V, Hash, Allocator>::get(const K& key) {
+    std::size_t slot = find_slot(key, mix(hasher_(key)));
+    Entry entry = index_[slot].entry;
+    if (entry == Entry{}) {
+        misses_++;
+        return nullptr;
+    }
+
+    hits_++;
+    entries_.splice(entries_.begin(), entries_, entry);
+    return &entry->second;
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+bool structures::LRUCache<K, V, Hash, Allocator>::put(const K& key,
+                                                      const V& value) {
+    std::size_t hash = mix(hasher_(key));
+    std::size_t slot = find_slot(key, hash);
+    if (index_[slot].entry != Entry{}) {
+        Entry entry = index_[slot].entry;
+        entry->second = value;
+        entries_.splice(entries_.begin(), entries_, entry);
+        return false;
+    }
+
+    Entry entry;
+    if (entries_.size() == capacity_) {
+        /// Reaproveita o nodo da menos recente: nenhuma alocacao
+        entry = --entries_.end();
+        erase_slot(find_slot(entry->first, mix(hasher_(entry->first))));
+        entry->first = key;
+        entry->second = value;
+        entries_.splice(entries_.begin(), entries_, entry);
+        slot = find_slot(key, hash);  // o deslocamento pode ter mudado a vaga
+    } else {
+        entry = entries_.insert_before(entries_.begin(),
+                                       std::make_pair(key, value));
+    }
+
+    index_[slot].hash = hash;
+    index_[slot].entry = entry;
+    return true;
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+bool structures::LRUCache<K, V, Hash, Allocator>::erase(const K& key) {
+    std::size_t slot = find_slot(key, mix(hasher_(key)));
+    Entry entry = index_[slot].entry;
+    if (entry == Entry{})
+        return false;
+
+    erase_slot(slot);
+    entries_.erase(entry);
+    return true;
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+bool structures::LRUCache<K, V, Hash, Allocator>::contains(const K& key) const {
+    return index_[find_slot(key, mix(hasher_(key)))].entry != Entry{};
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+void structures::LRUCache<K, V, Hash, Allocator>::clear() {
+    entries_.clear();
+    for (auto& slot : index_)
+        slot.entry = Entry{};
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+bool structures::LRUCache<K, V, Hash, Allocator>::empty() const {
+    return entries_.empty();
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+std::size_t structures::LRUCache<K, V, Hash, Allocator>::size() const {
+    return entries_.size();
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+std::size_t structures::LRUCache<K, V, Hash, Allocator>::capacity() const {
+    return capacity_;
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+std::size_t structures::LRUCache<K, V, Hash, Allocator>::hits() const {
+    return hits_;
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+std::size_t structures::LRUCache<K, V, Hash, Allocator>::misses() const {
+    return misses_;
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+void structures::LRUCache<K, V, Hash, Allocator>::reset_stats() {
+    hits_ = 0;
+    misses_ = 0;
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+std::size_t structures::LRUCache<K, V, Hash, Allocator>::mix(std::size_t hash) {
+    /// Finalizador do MurmurHash3: os bits baixos, que escolhem a posicao,
+    /// passam a depender de todos os bits do hash
+    std::uint64_t h = hash;
+    h ^= h >> 33;
+    h *= UINT64_C(0xff51afd7ed558ccd);
+    h ^= h >> 33;
+    h *= UINT64_C(0xc4ceb9fe1a85ec53);
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+std::size_t structures::LRUCache<K, V, Hash, Allocator>::find_slot(
+    const K& key, std::size_t hash) const {
+    std::size_t slot = hash & mask_;
+    while (index_[slot].entry != Entry{}) {
+        if ((index_[slot].hash == hash) && (index_[slot].entry->first == key))
+            return slot;
+        slot = (slot + 1) & mask_;
+    }
+
+    return slot;
+}
+
+template<typename K, typename V, typename Hash,
+         template<typename> class Allocator>
+void structures::LRUCache<K, V, Hash, Allocator>::erase_slot(std::size_t slot) {
+    std::size_t next = slot;
+    while (true) {
+        next = (next + 1) & mask_;
+        if (index_[next].entry == Entry{})
+            break;
+
+        /// Move a chave se sua posicao ideal nao esta em (slot, next]
+        std::size_t ideal = index_[next].hash & mask_;
+        if (((next - ideal) & mask_) >= ((next - slot) & mask_)) {
+            index_[slot] = index_[next];
+            slot = next;
+        }
+    }
+
+    index_[slot].entry = Entry{};
+}
@@ -0,0 +1,177 @@
+#include <cstdlib>
+#include <ctime>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "lru_cache.hpp"
+
+int main(int argc, char* argv[]) {
+    std::srand(std::time(NULL));
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class LRUCacheTest: public ::testing::Test {
+protected:
+    structures::LRUCache<int, int> cache{4u};
+};
+
+
+TEST_F(LRUCacheTest, Empty) {
+    ASSERT_TRUE(cache.empty());
+    ASSERT_EQ(0u, cache.size());
+    ASSERT_EQ(4u, cache.capacity());
+    ASSERT_EQ(nullptr, cache.get(0));
+}
+
+TEST_F(LRUCacheTest, InvalidCapacity) {
+    ASSERT_THROW((structures::LRUCache<int, int>{0u}), std::invalid_argument);
+}
+
+TEST_F(LRUCacheTest, PutGet) {
+    for (auto i = 0; i < 4; ++i) {
+        ASSERT_TRUE(cache.put(i, 10 * i));
+    }
+    ASSERT_EQ(4u, cache.size());
+    for (auto i = 0; i < 4; ++i) {
+        ASSERT_TRUE(cache.contains(i));
+        ASSERT_EQ(10 * i, *cache.get(i));
+    }
+}
+
+TEST_F(LRUCacheTest, PutUpdates) {
+    cache.put(1, 10);
+    ASSERT_FALSE(cache.put(1, 11));
+    ASSERT_EQ(1u, cache.size());
+    ASSERT_EQ(11, *cache.get(1));
+    *cache.get(1) = 12;
+    ASSERT_EQ(12, *cache.get(1));
+}
+
+TEST_F(LRUCacheTest, EvictsLeastRecentlyUsed) {
+    for (auto i = 0; i < 4; ++i) {
+        cache.put(i, i);
+    }
+    cache.get(0);  // 1 passa a ser o menos recente
+    cache.put(4, 4);
+    ASSERT_EQ(4u, cache.size());
+    ASSERT_FALSE(cache.contains(1));
+    ASSERT_TRUE(cache.contains(0));
+    cache.put(2, 20);  // atualizar tambem promove
+    cache.put(5, 5);
+    ASSERT_FALSE(cache.contains(3));
+    ASSERT_EQ(20, *cache.get(2));
+    ASSERT_EQ(4u, cache.size());
+}
+
+TEST_F(LRUCacheTest, Erase) {
+    for (auto i = 0; i < 4; ++i) {
+        cache.put(i, i);
+    }
+    ASSERT_TRUE(cache.erase(2));
+    ASSERT_FALSE(cache.erase(2));
+    ASSERT_EQ(3u, cache.size());
+    ASSERT_FALSE(cache.contains(2));
+    cache.put(4, 4);  // ha espaco: nada e' descartado
+    for (auto i : {0, 1, 3, 4}) {
+        ASSERT_TRUE(cache.contains(i));
+    }
+    cache.clear();
+    ASSERT_TRUE(cache.empty());
+    ASSERT_FALSE(cache.contains(0));
+    cache.put(0, 0);
+    ASSERT_EQ(0, *cache.get(0));
+}
+
+TEST_F(LRUCacheTest, Counters) {
+    cache.put(1, 1);
+    cache.get(1);
+    cache.get(1);
+    cache.get(2);
+    cache.contains(3);
+    ASSERT_EQ(2u, cache.hits());
+    ASSERT_EQ(1u, cache.misses());
+    cache.reset_stats();
+    ASSERT_EQ(0u, cache.hits());
+    ASSERT_EQ(0u, cache.misses());
+}
+
+TEST_F(LRUCacheTest, StringKeys) {
+    structures::LRUCache<std::string, std::string> strings{2u};
+    strings.put("a", "1");
+    strings.put("b", "2");
+    strings.get("a");
+    strings.put("c", "3");
+    ASSERT_FALSE(strings.contains("b"));
+    ASSERT_EQ("1", *strings.get("a"));
+    ASSERT_EQ("3", *strings.get("c"));
+}
+
+TEST_F(LRUCacheTest, InterleavedErase) {
+    /// Remocoes intercaladas exercitam o deslocamento para tras do indice
+    structures::LRUCache<int, int> interleaved{64u};
+    for (auto i = 0; i < 64; ++i) {
+        interleaved.put(i * 128, i);
+    }
+    for (auto i = 0; i < 64; i += 2) {
+        ASSERT_TRUE(interleaved.erase(i * 128));
+    }
+    for (auto i = 0; i < 64; ++i) {
+        ASSERT_EQ(i % 2 == 1, interleaved.contains(i * 128));
+    }
+}
+
+TEST_F(LRUCacheTest, MatchesReference) {
+    /// Compara com uma implementacao de referencia em operacoes aleatorias
+    structures::LRUCache<int, int, std::hash<int>,
+                         structures::PoolAllocator> lru{50u};
+    std::list<std::pair<int, int>> order;
+    std::unordered_map<int, std::list<std::pair<int, int>>::iterator> where;
+    for (auto i = 0; i < 20000; ++i) {
+        auto key = std::rand() % 200;
+        auto found = where.find(key);
+        switch (std::rand() % 3) {
+        case 0: {
+            auto value = lru.get(key);
+            ASSERT_EQ(found != where.end(), value != nullptr);
+            if (value != nullptr) {
+                ASSERT_EQ(found->second->second, *value);
+                order.splice(order.begin(), order, found->second);
+            }
+            break;
+        }
+        case 1:
+            ASSERT_EQ(found == where.end(), lru.put(key, i));
+            if (found != where.end()) {
+                order.erase(found->second);
+            } else if (order.size() == 50u) {
+                where.erase(order.back().first);
+                order.pop_back();
+            }
+            order.emplace_front(key, i);
+            where[key] = order.begin();
+            break;
+        default:
+            ASSERT_EQ(found != where.end(), lru.erase(key));
+            if (found != where.end()) {
+                order.erase(found->second);
+                where.erase(found);
+            }
+        }
+        ASSERT_EQ(order.size(), lru.size());
+    }
+}
+
+TEST_F(LRUCacheTest, HighBitKeys) {
+    /// Chaves que diferem apenas nos bits altos
+    structures::LRUCache<long long, int> wide{1000u};
+    for (auto i = 0; i < 1000; ++i) {
+        wide.put(static_cast<long long>(i) << 40, i);
+    }
+    for (auto i = 0; i < 1000; ++i) {
+        ASSERT_EQ(i, *wide.get(static_cast<long long>(i) << 40));
+    }
+}
@@ -0,0 +1,451 @@
+/// Copyright [2018] <João Fellipe Uller>
+#ifndef STRUCTURES_HASH_MAP_H
+#define STRUCTURES_HASH_MAP_H
+
+#include <cstdint>
+#include <cstring>  // std::memset
+#include <functional>  // std::hash
+#include <new>  // placement new
+#include <stdexcept>  // C++ exceptions
+#include <utility>
+
+#define DEFAULT_BUCKETS 16u
+#define MAX_LOAD_NUMERATOR 7u  // fator de carga maximo: 7/8
+#define MAX_LOAD_DENOMINATOR 8u
+
+namespace structures {
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+/// Tabela hash de enderecamento aberto com hashing Robin Hood
+///
+/// Sondagem linear em um vetor de tamanho potencia de 2. Cada posicao tem um
+/// byte de controle, guardado num vetor separado dos dados: 0 se a posicao
+/// esta vazia, senao a distancia da posicao ideal do elemento mais 1. Na
+/// insercao, um elemento mais perto de casa cede a posicao ao que esta mais
+/// longe (Robin Hood), o que mantem as sondagens curtas e permite parar uma
+/// busca sem sucesso assim que a distancia do residente for menor que a
+/// percorrida. A remocao desloca os seguintes para tras (sem lapides).
+class HashTable {
+ public:
+    /// Construtores/Destrutor
+    HashTable();
+
+    HashTable(const HashTable& other);
+
+    HashTable(HashTable&& other);
+
+    ~HashTable();
+
+    /// Atribuicao por copia ou movimento
+    HashTable& operator=(HashTable other);
+
+    /// Remove a chave; retorna se ela existia
+    bool remove(const K& key);
+
+    /// Retorna se a chave existe na tabela
+    bool contains(const K& key) const;
+
+    /// Limpa a tabela (mantem as posicoes reservadas)
+    void clear();
+
+    /// Retorna se a tabela esta vazia
+    bool empty() const;
+
+    /// Retorna o numero de elementos
+    std::size_t size() const;
+
+    /// Garante espaco para ao menos count elementos sem rehash
+    void reserve(std::size_t count);
+
+ protected:
+    /// Elemento com a chave, ou nullptr
+    T* lookup(const K& key) const;
+
+    /// Insere um elemento cuja chave nao esta na tabela
+    void insert_new(T&& value);
+
+ private:
+    /// Espalha os bits do hash (std::hash de inteiros e' a identidade)
+    std::size_t hash(const K& key) const;
+
+    /// Posicao da chave, ou capacity_ se ausente
+    std::size_t find(const K& key) const;
+
+    /// Simula a insercao: nenhuma distancia passaria do limite do byte?
+    bool fits(std::size_t hash) const;
+
+    /// Troca o vetor de posicoes por um de new_capacity e reinsere tudo
+    void rehash(std::size_t new_capacity);
+
+    /// Libera elementos e vetores
+    void release();
+
+    T* slots_{nullptr};
+    std::uint8_t* control_{nullptr};  // 0: vazia; senao distancia + 1
+    std::size_t capacity_{0u};
+    std::size_t size_{0u};
+    Hash hasher_;
+};
+
+template<typename K, typename V>
+/// Extrai a chave de um par chave/valor
+struct PairKey {
+    static const K& key(const std::pair<K, V>& pair) {
+        return pair.first;
+    }
+};
+
+template<typename K>
+/// O proprio elemento e' a chave
+struct IdentityKey {
+    static const K& key(const K& key) {
+        return key;
+    }
+};
+
+template<typename K, typename V, typename Hash = std::hash<K>>
+/// Mapa hash (chave -> valor) com hashing Robin Hood
+class HashMap:
+    public HashTable<std::pair<K, V>, K, PairKey<K, V>, Hash> {
+ public:
+    /// Insere o par; se a chave ja existe, nada muda. Retorna se inseriu
+    bool insert(const K& key, const V& value);
+
+    /// Insere o par ou atualiza o valor. Retorna se a chave era nova
+    bool insert_or_assign(const K& key, const V& value);
+
+    /// Valor da chave, ou nullptr se ausente
+    V* find(const K& key);
+
+    const V* find(const K& key) const;
+
+    /// Valor da chave (checando existencia)
+    V& at(const K& key);
+
+    const V& at(const K& key) const;
+
+    /// Valor da chave, inserido com V() se ausente
+    V& operator[](const K& key);
+};
+
+template<typename K, typename Hash = std::hash<K>>
+/// Conjunto hash com hashing Robin Hood
+class HashSet: public HashTable<K, K, IdentityKey<K>, Hash> {
+ public:
+    /// Insere a chave; retorna se ela era nova
+    bool insert(const K& key);
+};
+
+}  // namespace structures
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+structures::HashTable<T, K, KeyOf, Hash>::HashTable() {}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+structures::HashTable<T, K, KeyOf, Hash>::HashTable(const HashTable& other):
+    hasher_{other.hasher_}
+{
+    reserve(other.size_);
+    try {
+        for (std::size_t i = 0; i < other.capacity_; i++) {
+            if (other.control_[i] != 0)
+                insert_new(T(other.slots_[i]));
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+structures::HashTable<T, K, KeyOf, Hash>::HashTable(HashTable&& other):
+    slots_{other.slots_},
+    control_{other.control_},
+    capacity_{other.capacity_},
+    size_{other.size_},
+    hasher_{other.hasher_}
+{
+    other.slots_ = nullptr;
+    other.control_ = nullptr;
+    other.capacity_ = 0;
+    other.size_ = 0;
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+structures::HashTable<T, K, KeyOf, Hash>::~HashTable() {
+    release();
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+structures::HashTable<T, K, KeyOf, Hash>&
+structures::HashTable<T, K, KeyOf, Hash>::operator=(HashTable other) {
+    std::swap(slots_, other.slots_);
+    std::swap(control_, other.control_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(hasher_, other.hasher_);
+    return *this;
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+bool structures::HashTable<T, K, KeyOf, Hash>::remove(const K& key) {
+    std::size_t i = find(key);
+    if (i == capacity_)
+        return false;
+
+    /// Deslocamento para tras: puxa os seguintes que nao estao em casa
+    std::size_t mask = capacity_ - 1;
+    std::size_t next = (i + 1) & mask;
+    while (control_[next] > 1) {
+        slots_[i] = std::move(slots_[next]);
+        control_[i] = control_[next] - 1;
+        i = next;
+        next = (next + 1) & mask;
+    }
+
+    slots_[i].~T();
+    control_[i] = 0;
+    size_--;
+    return true;
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+bool structures::HashTable<T, K, KeyOf, Hash>::contains(const K& key) const {
+    return find(key) != capacity_;
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+void structures::HashTable<T, K, KeyOf, Hash>::clear() {
+    for (std::size_t i = 0; i < capacity_; i++) {
+        if (control_[i] != 0) {
+            slots_[i].~T();
+            control_[i] = 0;
+        }
+    }
+    size_ = 0;
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+bool structures::HashTable<T, K, KeyOf, Hash>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+std::size_t structures::HashTable<T, K, KeyOf, Hash>::size() const {
+    return size_;
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+void structures::HashTable<T, K, KeyOf, Hash>::reserve(std::size_t count) {
+    std::size_t new_capacity = DEFAULT_BUCKETS;
+    while (new_capacity * MAX_LOAD_NUMERATOR < count * MAX_LOAD_DENOMINATOR)
+        new_capacity *= 2;
+
+    if (new_capacity > capacity_)
+        rehash(new_capacity);
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+T* structures::HashTable<T, K, KeyOf, Hash>::lookup(const K& key) const {
+    std::size_t i = find(key);
+    return (i == capacity_) ? nullptr : &slots_[i];
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+void structures::HashTable<T, K, KeyOf, Hash>::insert_new(T&& value) {
+    if ((size_ + 1) * MAX_LOAD_DENOMINATOR > capacity_ * MAX_LOAD_NUMERATOR)
+        rehash(capacity_ == 0 ? DEFAULT_BUCKETS : 2 * capacity_);
+
+    std::size_t h = hash(KeyOf::key(value));
+    while (!fits(h)) {
+        /// Sondagem longa demais para o byte de controle. Com carga abaixo
+        /// de 1/8, crescer nao resolve: o hash e' degenerado
+        if (size_ * MAX_LOAD_DENOMINATOR < capacity_)
+            throw std::length_error("Too many collisions!");
+        rehash(2 * capacity_);
+    }
+
+    std::size_t mask = capacity_ - 1;
+    std::size_t i = h & mask;
+    std::uint8_t distance = 1;
+    T carried(std::move(value));
+    while (true) {
+        if (control_[i] == 0) {
+            new (&slots_[i]) T(std::move(carried));
+            control_[i] = distance;
+            size_++;
+            return;
+        }
+
+        if (control_[i] < distance) {  // residente mais perto de casa: cede
+            std::swap(carried, slots_[i]);
+            std::swap(distance, control_[i]);
+        }
+
+        i = (i + 1) & mask;
+        distance++;
+    }
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+std::size_t structures::HashTable<T, K, KeyOf, Hash>::hash(const K& key) const {
+    /// Finalizador do MurmurHash3: os bits baixos, que escolhem a posicao,
+    /// passam a depender de todos os bits do hash
+    std::uint64_t h = hasher_(key);
+    h ^= h >> 33;
+    h *= UINT64_C(0xff51afd7ed558ccd);
+    h ^= h >> 33;
+    h *= UINT64_C(0xc4ceb9fe1a85ec53);
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+std::size_t structures::HashTable<T, K, KeyOf, Hash>::find(const K& key) const {
+    if (size_ == 0)
+        return capacity_;
+
+    std::size_t mask = capacity_ - 1;
+    std::size_t i = hash(key) & mask;
+    std::uint8_t distance = 1;
+    /// Um residente mais perto de casa do que a distancia percorrida
+    /// indica que a chave nao esta na tabela
+    while (control_[i] >= distance) {
+        if ((control_[i] == distance) && (KeyOf::key(slots_[i]) == key))
+            return i;
+        i = (i + 1) & mask;
+        distance++;
+    }
+
+    return capacity_;
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+bool structures::HashTable<T, K, KeyOf, Hash>::fits(std::size_t hash) const {
+    std::size_t mask = capacity_ - 1;
+    std::size_t i = hash & mask;
+    std::uint8_t distance = 1;
+    while (control_[i] != 0) {
+        if (control_[i] < distance)
+            distance = control_[i];  // o residente passa a ser o carregado
+        i = (i + 1) & mask;
+        distance++;
+        if (distance == UINT8_MAX)
+            return false;
+    }
+
+    return true;
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+void structures::HashTable<T, K, KeyOf, Hash>::rehash(std::size_t new_capacity) {
+    T* old_slots = slots_;
+    std::uint8_t* old_control = control_;
+    std::size_t old_capacity = capacity_;
+
+    control_ = new std::uint8_t[new_capacity];
+    try {
+        slots_ = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
+    } catch (...) {
+        delete[] control_;
+        control_ = old_control;
+        throw;
+    }
+    std::memset(control_, 0, new_capacity);
+    capacity_ = new_capacity;
+    size_ = 0;
+
+    for (std::size_t i = 0; i < old_capacity; i++) {
+        if (old_control[i] != 0) {
+            insert_new(std::move(old_slots[i]));
+            old_slots[i].~T();
+        }
+    }
+
+    ::operator delete(old_slots);
+    delete[] old_control;
+}
+
+template<typename T, typename K, typename KeyOf, typename Hash>
+void structures::HashTable<T, K, KeyOf, Hash>::release() {
+    clear();
+    ::operator delete(slots_);
+    delete[] control_;
+    slots_ = nullptr;
+    control_ = nullptr;
+    capacity_ = 0;
+}
+
+template<typename K, typename V, typename Hash>
+bool structures::HashMap<K, V, Hash>::insert(const K& key, const V& value) {
+    if (this->contains(key))
+        return false;
+
+    this->insert_new(std::pair<K, V>(key, value));
+    return true;
+}
+
+template<typename K, typename V, typename Hash>
+bool structures::HashMap<K, V, Hash>::insert_or_assign(const K& key,
+                                                       const V& value) {
+    std::pair<K, V>* pair = this->lookup(key);
+    if (pair != nullptr) {
+        pair->second = value;
+        return false;
+    }
+
+    this->insert_new(std::pair<K, V>(key, value));
+    return true;
+}
+
+template<typename K, typename V, typename Hash>
+V* structures::HashMap<K, V, Hash>::find(const K& key) {
+    std::pair<K, V>* pair = this->lookup(key);
+    return (pair == nullptr) ? nullptr : &pair->second;
+}
+
+template<typename K, typename V, typename Hash>
+const V* structures::HashMap<K, V, Hash>::find(const K& key) const {
+    const std::pair<K, V>* pair = this->lookup(key);
+    return (pair == nullptr) ? nullptr : &pair->second;
+}
+
+template<typename K, typename V, typename Hash>
+V& structures::HashMap<K, V, Hash>::at(const K& key) {
+    V* value = find(key);
+    if (value == nullptr)
+        throw std::out_of_range("Key not found");
+
+    return *value;
+}
+
+template<typename K, typename V, typename Hash>
+const V& structures::HashMap<K, V, Hash>::at(const K& key) const {
+    const V* value = find(key);
+    if (value == nullptr)
+        throw std::out_of_range("Key not found");
+
+    return *value;
+}
+
+template<typename K, typename V, typename Hash>
+V& structures::HashMap<K, V, Hash>::operator[](const K& key) {
+    std::pair<K, V>* pair = this->lookup(key);
+    if (pair == nullptr) {
+        this->insert_new(std::pair<K, V>(key, V()));
+        pair = this->lookup(key);
+    }
+
+    return pair->second;
+}
+
+template<typename K, typename Hash>
+bool structures::HashSet<K, Hash>::insert(const K& key) {
+    if (this->contains(key))
+        return false;
+
+    this->insert_new(K(key));
+    return true;
+}
+
+#endif
@@ -0,0 +1,169 @@
+#include <cstdlib>
+#include <ctime>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "hash_map.hpp"
+
+int main(int argc, char* argv[]) {
+    std::srand(std::time(NULL));
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class HashMapTest: public ::testing::Test {
+protected:
+    structures::HashMap<int, int> map{};
+    structures::HashSet<int> set{};
+};
+
+/// Hash ruim: todas as chaves na mesma posicao ideal
+struct ConstantHash {
+    std::size_t operator()(int) const {
+        return 0u;
+    }
+};
+
+
+TEST_F(HashMapTest, Empty) {
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(0u, map.size());
+    ASSERT_FALSE(map.contains(0));
+    ASSERT_EQ(nullptr, map.find(0));
+    ASSERT_THROW(map.at(0), std::out_of_range);
+    ASSERT_FALSE(map.remove(0));
+}
+
+TEST_F(HashMapTest, Insert) {
+    for (auto i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(map.insert(i, -i));
+    }
+    ASSERT_EQ(1000u, map.size());
+    for (auto i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(map.contains(i));
+        ASSERT_EQ(-i, map.at(i));
+    }
+    ASSERT_FALSE(map.contains(1000));
+}
+
+TEST_F(HashMapTest, InsertExisting) {
+    ASSERT_TRUE(map.insert(1, 10));
+    ASSERT_FALSE(map.insert(1, 11));
+    ASSERT_EQ(10, map.at(1));
+    ASSERT_FALSE(map.insert_or_assign(1, 12));
+    ASSERT_EQ(12, map.at(1));
+    ASSERT_TRUE(map.insert_or_assign(2, 20));
+    ASSERT_EQ(2u, map.size());
+}
+
+TEST_F(HashMapTest, Subscript) {
+    map[1] = 10;
+    map[1] += 5;
+    ASSERT_EQ(15, map.at(1));
+    ASSERT_EQ(0, map[2]);
+    ASSERT_EQ(2u, map.size());
+    *map.find(2) = 7;
+    ASSERT_EQ(7, map[2]);
+}
+
+TEST_F(HashMapTest, Remove) {
+    for (auto i = 0; i < 1000; ++i) {
+        map.insert(i, i);
+    }
+    for (auto i = 0; i < 1000; i += 2) {
+        ASSERT_TRUE(map.remove(i));
+    }
+    ASSERT_FALSE(map.remove(0));
+    ASSERT_EQ(500u, map.size());
+    for (auto i = 0; i < 1000; ++i) {
+        ASSERT_EQ(i % 2 == 1, map.contains(i));
+    }
+}
+
+TEST_F(HashMapTest, Clear) {
+    for (auto i = 0; i < 100; ++i) {
+        map.insert(i, i);
+    }
+    map.clear();
+    ASSERT_TRUE(map.empty());
+    ASSERT_FALSE(map.contains(5));
+    map.insert(5, 5);
+    ASSERT_EQ(5, map.at(5));
+}
+
+TEST_F(HashMapTest, CopyAndMove) {
+    structures::HashMap<std::string, int> strings{};
+    for (auto i = 0; i < 100; ++i) {
+        strings.insert(std::to_string(i), i);
+    }
+    auto copy = strings;
+    copy.remove("0");
+    ASSERT_TRUE(strings.contains("0"));
+    ASSERT_EQ(99u, copy.size());
+    ASSERT_EQ(42, copy.at("42"));
+
+    auto moved = std::move(copy);
+    ASSERT_EQ(99u, moved.size());
+    ASSERT_TRUE(copy.empty());
+    copy = moved;
+    ASSERT_EQ(99, copy.at("99"));
+    copy.insert("x", 1);
+    ASSERT_EQ(1, copy.at("x"));
+}
+
+TEST_F(HashMapTest, Reserve) {
+    map.reserve(1000);
+    for (auto i = 0; i < 1000; ++i) {
+        map.insert(i, i);
+    }
+    ASSERT_EQ(1000u, map.size());
+    ASSERT_EQ(999, map.at(999));
+}
+
+TEST_F(HashMapTest, LongProbes) {
+    /// Com hash constante as sondagens chegam ao limite do byte de controle
+    structures::HashSet<int, ConstantHash> bad{};
+    for (auto i = 0; i < 200; ++i) {
+        ASSERT_TRUE(bad.insert(i));
+    }
+    ASSERT_THROW(for (auto i = 200; i < 300; ++i) bad.insert(i),
+                 std::length_error);
+    auto size = bad.size();
+    ASSERT_LT(200u, size);
+    for (auto i = 0; i < static_cast<int>(size); ++i) {
+        ASSERT_TRUE(bad.contains(i));
+    }
+    ASSERT_FALSE(bad.contains(static_cast<int>(size)));
+    for (auto i = 0; i < 200; i += 2) {
+        ASSERT_TRUE(bad.remove(i));
+    }
+    for (auto i = 0; i < 200; ++i) {
+        ASSERT_EQ(i % 2 == 1, bad.contains(i));
+    }
+}
+
+TEST_F(HashMapTest, Set) {
+    ASSERT_TRUE(set.insert(3));
+    ASSERT_FALSE(set.insert(3));
+    ASSERT_TRUE(set.contains(3));
+    ASSERT_TRUE(set.remove(3));
+    ASSERT_TRUE(set.empty());
+}
+
+TEST_F(HashMapTest, MatchesReference) {
+    std::set<int> reference;
+    for (auto i = 0; i < 50000; ++i) {
+        auto key = std::rand() % 2000;
+        if (std::rand() % 2 == 0) {
+            ASSERT_EQ(reference.insert(key).second, set.insert(key));
+        } else {
+            ASSERT_EQ(reference.erase(key) == 1u, set.remove(key));
+        }
+        ASSERT_EQ(reference.size(), set.size());
+    }
+    for (auto i = 0; i < 2000; ++i) {
+        ASSERT_EQ(reference.count(i) == 1u, set.contains(i));
+    }
+}
@@ -3,9 +3,22 @@
 #define STRUCTURES_ARRAY_LIST_H
 
 #include <cstdint>
+#include <cstring>  // std::memmove
+#include <iterator>
+#include <new>  // placement new
 #include <stdexcept>  // C++ exceptions
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>  // SSE2
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>  // AVX2
+#endif
 
 #define DEFAULT_MAX 10u
+#define DEFAULT_GROWTH 2.0
 
 namespace structures {
 
@@ -19,20 +32,45 @@ class ArrayList {
 
     explicit ArrayList(std::size_t max_size);
 
+    /// Lista crescente: ao encher, a capacidade e' multiplicada por growth_factor
+    ArrayList(std::size_t max_size, double growth_factor);
+
+    ArrayList(const ArrayList& other);
+
+    ArrayList(ArrayList&& other);
+
     ~ArrayList();
 
+    /// Atribuicao por copia ou movimento
+    ArrayList& operator=(ArrayList other);
+
     /// Limpa a lista logicamente
     void clear();
 
     /// Insere um elemento no fim da lista
     void push_back(const T& data);
 
+    /// Insere um elemento no fim da lista (movendo-o)
+    void push_back(T&& data);
+
+    /// Constroi um elemento diretamente no fim da lista
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+
     /// Insere um elemento no inicio da lista
     void push_front(const T& data);
 
     /// Insere um elemento
     void insert(const T& data, std::size_t index);
 
+    /// Insere um elemento (movendo-o)
+    void insert(T&& data, std::size_t index);
+
+    /// Insere os elementos de [first, last) a partir de index (um unico
+    /// deslocamento para todo o intervalo, que nao pode pertencer a lista)
+    template<typename ForwardIt>
+    void insert_range(ForwardIt first, ForwardIt last, std::size_t index);
+
     /// Insere um elemento em ordem
     void insert_sorted(const T& data);
 
@@ -48,6 +86,9 @@ class ArrayList {
     /// Remove um elemento
     void remove(const T& data);
 
+    /// Remove os elementos com indice em [first_index, last_index)
+    void erase_range(std::size_t first_index, std::size_t last_index);
+
     /// Testa se a lista esta cheia
     bool full() const;
 
@@ -60,12 +101,37 @@ class ArrayList {
     /// Retorna o indice de dado elemento na lista (-1 se nao existir)
     std::size_t find(const T& data) const;
 
+    /// Metodos para listas ordenadas (mantidas com insert_sorted), em O(log n)
+    /// Indice do primeiro elemento que nao e' menor que data
+    std::size_t lower_bound(const T& data) const;
+
+    /// Indice do primeiro elemento maior que data
+    std::size_t upper_bound(const T& data) const;
+
+    /// Busca binaria: indice do elemento (size() se nao existir)
+    std::size_t find_sorted(const T& data) const;
+
+    /// Busca binaria: verifica se um elemento existe na lista
+    bool contains_sorted(const T& data) const;
+
     /// Retorna o tamanho da lista
     std::size_t size() const;
 
     /// Retorna o tamanho maximo da lista
     std::size_t max_size() const;
 
+    /// Garante espaco para ao menos new_max_size elementos
+    void reserve(std::size_t new_max_size);
+
+    /// Reduz o tamanho maximo da lista ao seu tamanho atual
+    void shrink_to_fit();
+
+    /// Testa se a lista cresce ao encher (lista com tamanho maximo variavel)
+    bool growable() const;
+
+    /// Retorna o fator de crescimento da lista (0 se o tamanho maximo e' fixo)
+    double growth_factor() const;
+
     /// Retorna o elemento em determinado indice
     T& at(std::size_t index);
 
@@ -79,35 +145,133 @@ class ArrayList {
     const T& operator[](std::size_t index) const;
 
  private:
+    /// Aloca memoria crua (sem construir elementos) para max_size elementos
+    static T* allocate(std::size_t max_size);
+
+    /// Proximo tamanho maximo de uma lista crescente
+    std::size_t next_max_size() const;
+
+    /// Realoca o vetor de elementos com um novo tamanho maximo
+    void reallocate(std::size_t new_max_size);
+
+    /// Tipos trivialmente copiaveis sao deslocados com um unico memmove
+    typedef std::is_trivially_copyable<T> trivial;
+
+    /// Move count elementos de from para a memoria crua em to
+    static void relocate(T* to, T* from, std::size_t count, std::true_type);
+    static void relocate(T* to, T* from, std::size_t count, std::false_type);
+
+    /// Abre count posicoes (nao construidas) a partir de index
+    void open_gap(std::size_t index, std::size_t count, std::true_type);
+    void open_gap(std::size_t index, std::size_t count, std::false_type);
+
+    /// Fecha as count posicoes (ja destruidas) a partir de index
+    void close_gap(std::size_t index, std::size_t count, std::true_type);
+    void close_gap(std::size_t index, std::size_t count, std::false_type);
+
+    /// Busca vetorizada: tipos aritmeticos de 32/64 bits comparam varios
+    /// elementos por instrucao; demais tipos (ou sem SSE2) usam a busca escalar
+    enum SearchKernel { SCALAR, INT32, INT64, FLOAT, DOUBLE };
+    typedef std::integral_constant<SearchKernel,
+#if defined(__SSE2__)
+        std::is_same<T, float>::value ? FLOAT :
+        std::is_same<T, double>::value ? DOUBLE :
+        (std::is_integral<T>::value && sizeof(T) == 4) ? INT32 :
+        (std::is_integral<T>::value && sizeof(T) == 8) ? INT64 :
+#endif
+        SCALAR> search_kernel;
+
+    template<SearchKernel K>
+    using kernel = std::integral_constant<SearchKernel, K>;
+
+    std::size_t find_index(const T& data, kernel<SCALAR>) const;
+#if defined(__SSE2__)
+    std::size_t find_index(const T& data, kernel<INT32>) const;
+    std::size_t find_index(const T& data, kernel<INT64>) const;
+    std::size_t find_index(const T& data, kernel<FLOAT>) const;
+    std::size_t find_index(const T& data, kernel<DOUBLE>) const;
+#endif
+
     T* contents;
     std::size_t size_;
     std::size_t max_size_;
+    double growth_factor_{0};
 };
 
 }  // namespace structures
-#endif
 
 template <typename T>
 structures::ArrayList<T>::ArrayList() {
-    contents = new T[DEFAULT_MAX];
+    contents = allocate(DEFAULT_MAX);
     size_ = 0;
     max_size_ = DEFAULT_MAX;
 }
 
 template<typename T>
 structures::ArrayList<T>::ArrayList(std::size_t max_size) {
-    contents = new T[max_size];
+    contents = allocate(max_size);
+    size_ = 0;
+    max_size_ = max_size;
+}
+
+template<typename T>
+structures::ArrayList<T>::ArrayList(std::size_t max_size, double growth_factor) {
+    if (growth_factor <= 1)
+        throw std::invalid_argument("Invalid growth factor!");
+
+    contents = allocate(max_size);
     size_ = 0;
     max_size_ = max_size;
+    growth_factor_ = growth_factor;
+}
+
+template<typename T>
+structures::ArrayList<T>::ArrayList(const ArrayList& other) {
+    contents = allocate(other.max_size_);
+    size_ = 0;
+    max_size_ = other.max_size_;
+    growth_factor_ = other.growth_factor_;
+    try {
+        for (; size_ < other.size_; size_++)
+            new (contents + size_) T(other.contents[size_]);
+    } catch (...) {
+        clear();
+        ::operator delete(contents);
+        throw;
+    }
+}
+
+template<typename T>
+structures::ArrayList<T>::ArrayList(ArrayList&& other) {
+    contents = other.contents;
+    size_ = other.size_;
+    max_size_ = other.max_size_;
+    growth_factor_ = other.growth_factor_;
+
+    other.contents = nullptr;
+    other.size_ = 0;
+    other.max_size_ = 0;
 }
 
 template <typename T>
 structures::ArrayList<T>::~ArrayList() {
-    delete[] contents;
+    clear();
+    ::operator delete(contents);
+}
+
+template <typename T>
+structures::ArrayList<T>& structures::ArrayList<T>::operator=(ArrayList other) {
+    std::swap(contents, other.contents);
+    std::swap(size_, other.size_);
+    std::swap(max_size_, other.max_size_);
+    std::swap(growth_factor_, other.growth_factor_);
+    return *this;
 }
 
 template <typename T>
 void structures::ArrayList<T>::clear() {
+    for (std::size_t i = 0; i < size_; i++)
+        contents[i].~T();
     size_ = 0;
 }
 
@@ -116,6 +280,40 @@ void structures::ArrayList<T>::push_back(const T& data) {
     insert(data, size_);
 }
 
+template <typename T>
+void structures::ArrayList<T>::push_back(T&& data) {
+    emplace_back(std::move(data));
+}
+
+template <typename T>
+template <typename... Args>
+void structures::ArrayList<T>::emplace_back(Args&&... args) {
+    if (!full()) {
+        new (contents + size_) T(std::forward<Args>(args)...);
+        size_++;
+        return;
+    }
+    if (!growable())
+        throw std::out_of_range("Full list!");
+
+    /// O novo elemento e' construido antes de mover os antigos, pois args
+    /// pode referenciar um elemento da propria lista
+    std::size_t new_max_size = next_max_size();
+    T* new_contents = allocate(new_max_size);
+    try {
+        new (new_contents + size_) T(std::forward<Args>(args)...);
+    } catch (...) {
+        ::operator delete(new_contents);
+        throw;
+    }
+    relocate(new_contents, contents, size_, trivial());
+
+    ::operator delete(contents);
+    contents = new_contents;
+    max_size_ = new_max_size;
+    size_++;
+}
+
 template <typename T>
 void structures::ArrayList<T>::push_front(const T& data) {
     insert(data, 0);
@@ -123,29 +321,70 @@ void structures::ArrayList<T>::push_front(const T& data) {
 
 template <typename T>
 void structures::ArrayList<T>::insert(const T& data, std::size_t index) {
-    if (full())
-        throw std::out_of_range("Full list!");
-    if (index >= max_size_)
-        throw std::out_of_range("Invalid index!");
+    /// Copia antes de deslocar: data pode referenciar um elemento da lista
+    insert(T(data), index);
+}
 
-    if (index < size_)
-        for (unsigned int i = size_; i > index; i--)
-            contents[i] = contents[i-1];
+template <typename T>
+void structures::ArrayList<T>::insert(T&& data, std::size_t index) {
+    if (index > size_)
+        throw std::out_of_range("Invalid index!");
+    if (index == size_) {
+        emplace_back(std::move(data));
+        return;
+    }
+    if (full()) {
+        if (!growable())
+            throw std::out_of_range("Full list!");
+        reallocate(next_max_size());
+    }
 
-    contents[index] = data;
+    open_gap(index, 1, trivial());
+    new (contents + index) T(std::move(data));
     size_++;
 }
 
+template <typename T>
+template <typename ForwardIt>
+void structures::ArrayList<T>::insert_range(ForwardIt first, ForwardIt last,
+                                            std::size_t index) {
+    if (index > size_)
+        throw std::out_of_range("Invalid index!");
+
+    auto count = static_cast<std::size_t>(std::distance(first, last));
+    if (size_ + count > max_size_) {
+        if (!growable())
+            throw std::out_of_range("Full list!");
+
+        std::size_t new_max_size = next_max_size();
+        if (new_max_size < size_ + count)
+            new_max_size = size_ + count;
+        reallocate(new_max_size);
+    }
+
+    open_gap(index, count, trivial());
+    std::size_t i = 0;
+    try {
+        for (; first != last; ++first, ++i)
+            new (contents + index + i) T(*first);
+    } catch (...) {
+        /// Desfaz a insercao parcial
+        for (std::size_t j = 0; j < i; j++)
+            contents[index + j].~T();
+        size_ += count;
+        close_gap(index, count, trivial());
+        size_ -= count;
+        throw;
+    }
+    size_ += count;
+}
+
 template <typename T>
 void structures::ArrayList<T>::insert_sorted(const T& data) {
-    if (full())
+    if (full() && !growable())
         throw std::out_of_range("Full list!");
 
-    unsigned int i = 0;
-    while ((i < size_) && (data >= contents[i]))
-        i++;
-
-    insert(data, i);
+    insert(data, upper_bound(data));
 }
 
 template <typename T>
@@ -153,9 +392,9 @@ T structures::ArrayList<T>::pop(std::size_t index) {
     if (empty() || (index >= size_))
         throw std::out_of_range("Invalid index!");
 
-    T data = contents[index];
-    for (unsigned int i = index; i < size_ - 1; i++)
-        contents[i] = contents[i+1];
+    T data = std::move(contents[index]);
+    contents[index].~T();
+    close_gap(index, 1, trivial());
     size_--;
     return data;
 }
@@ -175,6 +414,18 @@ void structures::ArrayList<T>::remove(const T& data) {
     pop(find(data));
 }
 
+template <typename T>
+void structures::ArrayList<T>::erase_range(std::size_t first_index,
+                                           std::size_t last_index) {
+    if ((first_index > last_index) || (last_index > size_))
+        throw std::out_of_range("Invalid index!");
+
+    for (std::size_t i = first_index; i < last_index; i++)
+        contents[i].~T();
+    close_gap(first_index, last_index - first_index, trivial());
+    size_ -= last_index - first_index;
+}
+
 template <typename T>
 bool structures::ArrayList<T>::full() const {
     return size_ == max_size_;
@@ -187,21 +438,59 @@ bool structures::ArrayList<T>::empty() const {
 
 template <typename T>
 bool structures::ArrayList<T>::contains(const T& data) const {
-    for (unsigned int i = 0; i < size_; i++) {
-        if (contents[i] == data)
-            return true;
-    }
-    return false;
+    return find(data) != size_;
 }
 
 template <typename T>
 std::size_t structures::ArrayList<T>::find(const T& data) const {
-    unsigned int i = 0;
-    while ((i < size_) && (contents[i] != data)) {
-        i++;
+    return find_index(data, search_kernel());
+}
+
+template <typename T>
+std::size_t structures::ArrayList<T>::lower_bound(const T& data) const {
+    if (empty())
+        return 0;
+
+    /// Busca sem desvios: o laco so depende de size_, nao das comparacoes
+    const T* base = contents;
+    std::size_t length = size_;
+    while (length > 1) {
+        std::size_t half = length / 2;
+        base = (base[half] < data) ? base + half : base;
+        length -= half;
     }
 
-    return i;
+    return (base - contents) + (*base < data);
+}
+
+template <typename T>
+std::size_t structures::ArrayList<T>::upper_bound(const T& data) const {
+    if (empty())
+        return 0;
+
+    const T* base = contents;
+    std::size_t length = size_;
+    while (length > 1) {
+        std::size_t half = length / 2;
+        base = (data < base[half]) ? base : base + half;
+        length -= half;
+    }
+
+    return (base - contents) + !(data < *base);
+}
+
+template <typename T>
+std::size_t structures::ArrayList<T>::find_sorted(const T& data) const {
+    std::size_t i = lower_bound(data);
+    if ((i < size_) && (contents[i] == data))
+        return i;
+
+    return size_;
+}
+
+template <typename T>
+bool structures::ArrayList<T>::contains_sorted(const T& data) const {
+    return find_sorted(data) != size_;
 }
 
 template <typename T>
@@ -214,6 +503,28 @@ std::size_t structures::ArrayList<T>::max_size() const {
     return max_size_;
 }
 
+template <typename T>
+void structures::ArrayList<T>::reserve(std::size_t new_max_size) {
+    if (new_max_size > max_size_)
+        reallocate(new_max_size);
+}
+
+template <typename T>
+void structures::ArrayList<T>::shrink_to_fit() {
+    if (size_ < max_size_)
+        reallocate(size_);
+}
+
+template <typename T>
+bool structures::ArrayList<T>::growable() const {
+    return growth_factor_ > 0;
+}
+
+template <typename T>
+double structures::ArrayList<T>::growth_factor() const {
+    return growth_factor_;
+}
+
 template <typename T>
 T& structures::ArrayList<T>::at(std::size_t index) {
     if (index >= size_)
@@ -240,8 +551,251 @@ const T& structures::ArrayList<T>::at(std::size_t index) const {
 
 template <typename T>
 const T& structures::ArrayList<T>::operator[](std::size_t index) const {
-    if (index >= max_size_)
+    if (index >= size_)
         throw std::out_of_range("Invalid index!");
 
     return contents[index];
 }
+
+template <typename T>
+T* structures::ArrayList<T>::allocate(std::size_t max_size) {
+    /// Lista de tamanho maximo 0 (ex.: crescente, criada vazia) nao aloca
+    if (max_size == 0)
+        return nullptr;
+
+    return static_cast<T*>(::operator new(max_size * sizeof(T)));
+}
+
+template <typename T>
+std::size_t structures::ArrayList<T>::next_max_size() const {
+    /// Crescimento geometrico: push_back em O(1) amortizado
+    auto new_max_size = static_cast<std::size_t>(max_size_ * growth_factor_);
+    if (new_max_size <= max_size_)
+        new_max_size = max_size_ + 1;
+
+    return new_max_size;
+}
+
+template <typename T>
+void structures::ArrayList<T>::reallocate(std::size_t new_max_size) {
+    T* new_contents = allocate(new_max_size);
+    relocate(new_contents, contents, size_, trivial());
+
+    ::operator delete(contents);
+    contents = new_contents;
+    max_size_ = new_max_size;
+}
+
+template <typename T>
+void structures::ArrayList<T>::relocate(T* to, T* from, std::size_t count,
+                                        std::true_type) {
+    if (count > 0)
+        std::memmove(to, from, count * sizeof(T));
+}
+
+template <typename T>
+void structures::ArrayList<T>::relocate(T* to, T* from, std::size_t count,
+                                        std::false_type) {
+    for (std::size_t i = 0; i < count; i++) {
+        new (to + i) T(std::move(from[i]));
+        from[i].~T();
+    }
+}
+
+template <typename T>
+void structures::ArrayList<T>::open_gap(std::size_t index, std::size_t count,
+                                        std::true_type) {
+    if ((count > 0) && (index < size_))
+        std::memmove(contents + index + count, contents + index,
+                     (size_ - index) * sizeof(T));
+}
+
+template <typename T>
+void structures::ArrayList<T>::open_gap(std::size_t index, std::size_t count,
+                                        std::false_type) {
+    if (count == 0)
+        return;
+
+    /// Do fim para o inicio: posicoes alem de size_ ainda nao foram construidas
+    for (std::size_t i = size_; i > index; i--) {
+        std::size_t to = i - 1 + count;
+        if (to >= size_)
+            new (contents + to) T(std::move(contents[i-1]));
+        else
+            contents[to] = std::move(contents[i-1]);
+    }
+
+    /// As posicoes da lacuna que ainda guardam elementos movidos sao destruidas
+    for (std::size_t i = index; (i < index + count) && (i < size_); i++)
+        contents[i].~T();
+}
+
+template <typename T>
+void structures::ArrayList<T>::close_gap(std::size_t index, std::size_t count,
+                                         std::true_type) {
+    if ((count > 0) && (index + count < size_))
+        std::memmove(contents + index, contents + index + count,
+                     (size_ - index - count) * sizeof(T));
+}
+
+template <typename T>
+void structures::ArrayList<T>::close_gap(std::size_t index, std::size_t count,
+                                         std::false_type) {
+    if (count == 0)
+        return;
+
+    /// Posicoes da lacuna nao estao construidas; as demais recebem atribuicao
+    for (std::size_t i = index; i + count < size_; i++) {
+        if (i < index + count)
+            new (contents + i) T(std::move(contents[i + count]));
+        else
+            contents[i] = std::move(contents[i + count]);
+    }
+
+    /// Destroi os elementos movidos que sobraram no fim da lista
+    std::size_t first_moved = size_ - count;
+    if (first_moved < index + count)
+        first_moved = index + count;
+    for (std::size_t i = first_moved; i < size_; i++)
+        contents[i].~T();
+}
+
+template <typename T>
+std::size_t structures::ArrayList<T>::find_index(const T& data,
+                                                 kernel<SCALAR>) const {
+    std::size_t i = 0;
+    while ((i < size_) && (contents[i] != data)) {
+        i++;
+    }
+
+    return i;
+}
+
+#if defined(__SSE2__)
+/// Cada kernel compara um bloco de elementos e extrai o primeiro igual pela
+/// mascara (movemask); o resto que nao completa um bloco e' comparado um a um
+template <typename T>
+std::size_t structures::ArrayList<T>::find_index(const T& data,
+                                                 kernel<INT32>) const {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i key = _mm256_set1_epi32(static_cast<std::int32_t>(data));
+    for (; i + 8 <= size_; i += 8) {
+        __m256i block = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(contents + i));
+        int mask = _mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_cmpeq_epi32(block, key)));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+#else
+    const __m128i key = _mm_set1_epi32(static_cast<std::int32_t>(data));
+    for (; i + 4 <= size_; i += 4) {
+        __m128i block = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(contents + i));
+        int mask = _mm_movemask_ps(
+            _mm_castsi128_ps(_mm_cmpeq_epi32(block, key)));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+    while ((i < size_) && (contents[i] != data))
+        i++;
+
+    return i;
+}
+
+template <typename T>
+std::size_t structures::ArrayList<T>::find_index(const T& data,
+                                                 kernel<INT64>) const {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i key = _mm256_set1_epi64x(static_cast<long long>(data));
+    for (; i + 4 <= size_; i += 4) {
+        __m256i block = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(contents + i));
+        int mask = _mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpeq_epi64(block, key)));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+#else
+    /// SSE2 nao compara 64 bits: as duas metades de 32 bits devem ser iguais
+    const __m128i key = _mm_set1_epi64x(static_cast<long long>(data));
+    for (; i + 2 <= size_; i += 2) {
+        __m128i block = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(contents + i));
+        __m128i halves = _mm_cmpeq_epi32(block, key);
+        __m128i both = _mm_and_si128(
+            halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(both));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+    while ((i < size_) && (contents[i] != data))
+        i++;
+
+    return i;
+}
+
+template <typename T>
+std::size_t structures::ArrayList<T>::find_index(const T& data,
+                                                 kernel<FLOAT>) const {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 key = _mm256_set1_ps(data);
+    for (; i + 8 <= size_; i += 8) {
+        __m256 block = _mm256_loadu_ps(
+            reinterpret_cast<const float*>(contents + i));
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(block, key, _CMP_EQ_OQ));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+#else
+    const __m128 key = _mm_set1_ps(data);
+    for (; i + 4 <= size_; i += 4) {
+        __m128 block = _mm_loadu_ps(
+            reinterpret_cast<const float*>(contents + i));
+        int mask = _mm_movemask_ps(_mm_cmpeq_ps(block, key));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+    while ((i < size_) && (contents[i] != data))
+        i++;
+
+    return i;
+}
+
+template <typename T>
+std::size_t structures::ArrayList<T>::find_index(const T& data,
+                                                 kernel<DOUBLE>) const {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256d key = _mm256_set1_pd(data);
+    for (; i + 4 <= size_; i += 4) {
+        __m256d block = _mm256_loadu_pd(
+            reinterpret_cast<const double*>(contents + i));
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(block, key, _CMP_EQ_OQ));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+#else
+    const __m128d key = _mm_set1_pd(data);
+    for (; i + 2 <= size_; i += 2) {
+        __m128d block = _mm_loadu_pd(
+            reinterpret_cast<const double*>(contents + i));
+        int mask = _mm_movemask_pd(_mm_cmpeq_pd(block, key));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+    while ((i < size_) && (contents[i] != data))
+        i++;
+
+    return i;
+}
+#endif
+
+#endif
@@ -1,3 +1,5 @@
+#include <string>
+
 #include "gtest/gtest.h"
 #include "array_list.hpp"
 
@@ -7,6 +9,24 @@ int main(int argc, char* argv[]) {
     return RUN_ALL_TESTS();
 }
 
+/// Tipo que conta construcoes e copias, para testar a lista sem construcao previa
+struct Counted {
+    static int constructions;
+    static int copies;
+
+    Counted() { constructions++; }
+    explicit Counted(int value): value_{value} { constructions++; }
+    Counted(const Counted& other): value_{other.value_} { constructions++; copies++; }
+    Counted(Counted&& other): value_{other.value_} { constructions++; }
+    Counted& operator=(const Counted& other) { value_ = other.value_; copies++; return *this; }
+    Counted& operator=(Counted&& other) { value_ = other.value_; return *this; }
+
+    int value_{0};
+};
+
+int Counted::constructions = 0;
+int Counted::copies = 0;
+
 class ArrayListTest: public ::testing::Test {
 protected:
     structures::ArrayList<int> list{10u};
@@ -137,6 +157,13 @@ TEST_F(ArrayListTest, AccessAtBoundCheck) {
     ASSERT_THROW(list.at(-1), std::out_of_range);
 }
 
+TEST_F(ArrayListTest, ConstAccessBoundCheck) {
+    list.push_back(0);
+    const auto& constant = list;
+    ASSERT_EQ(0, constant[0]);
+    ASSERT_THROW(constant[constant.size()], std::out_of_range);
+}
+
 TEST_F(ArrayListTest, Insert) {
     for (auto i = 0; i < 5; ++i) {
         list.push_back(i);
@@ -224,3 +251,202 @@ TEST_F(ArrayListTest, RemoveElement) {
     ASSERT_EQ(9u, list.size());
     ASSERT_FALSE(list.contains(4));
 }
+
+TEST_F(ArrayListTest, GrowablePushBack) {
+    structures::ArrayList<int> growable{2u, 2.0};
+    ASSERT_TRUE(growable.growable());
+    for (auto i = 0; i < 100; ++i) {
+        growable.push_back(i);
+    }
+    ASSERT_EQ(100u, growable.size());
+    ASSERT_GE(growable.max_size(), 100u);
+    for (auto i = 0; i < 100; ++i) {
+        ASSERT_EQ(i, growable[i]);
+    }
+}
+
+TEST_F(ArrayListTest, GrowableInsertSelfReference) {
+    structures::ArrayList<int> growable{1u, 1.5};
+    growable.push_back(42);
+    growable.push_front(growable[0]);
+    ASSERT_EQ(2u, growable.size());
+    ASSERT_EQ(42, growable[0]);
+    ASSERT_EQ(42, growable[1]);
+}
+
+TEST_F(ArrayListTest, InvalidGrowthFactor) {
+    ASSERT_THROW((structures::ArrayList<int>{10u, 1.0}), std::invalid_argument);
+    ASSERT_FALSE(list.growable());
+}
+
+TEST_F(ArrayListTest, ReserveAndShrink) {
+    list.reserve(50u);
+    ASSERT_EQ(50u, list.max_size());
+    for (auto i = 0; i < 20; ++i) {
+        list.push_back(i);
+    }
+    list.shrink_to_fit();
+    ASSERT_EQ(20u, list.max_size());
+    ASSERT_TRUE(list.full());
+    for (auto i = 0; i < 20; ++i) {
+        ASSERT_EQ(i, list[i]);
+    }
+    list.reserve(10u);
+    ASSERT_EQ(20u, list.max_size());
+}
+
+TEST_F(ArrayListTest, NoDefaultConstruction) {
+    Counted::constructions = 0;
+    structures::ArrayList<Counted> counted{100u};
+    ASSERT_EQ(0, Counted::constructions);
+
+    counted.emplace_back(1);
+    ASSERT_EQ(1, Counted::constructions);
+}
+
+TEST_F(ArrayListTest, MoveShifting) {
+    structures::ArrayList<Counted> counted{4u, 2.0};
+    for (auto i = 0; i < 10; ++i) {
+        counted.emplace_back(i);
+    }
+    Counted::copies = 0;
+    counted.insert(Counted{-1}, 0u);
+    ASSERT_EQ(9, counted.pop_back().value_);
+    ASSERT_EQ(-1, counted.pop_front().value_);
+    ASSERT_EQ(0, Counted::copies);
+    ASSERT_EQ(9u, counted.size());
+    for (auto i = 0; i < 9; ++i) {
+        ASSERT_EQ(i, counted[i].value_);
+    }
+}
+
+TEST_F(ArrayListTest, CopyAndMove) {
+    for (auto i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    structures::ArrayList<int> copy{list};
+    copy.pop_back();
+    ASSERT_EQ(10u, list.size());
+    ASSERT_EQ(9u, copy.size());
+
+    structures::ArrayList<int> moved{std::move(copy)};
+    ASSERT_EQ(9u, moved.size());
+    ASSERT_EQ(8, moved[8]);
+
+    list = moved;
+    ASSERT_EQ(9u, list.size());
+}
+
+TEST_F(ArrayListTest, InsertRange) {
+    for (auto i = 0; i < 4; ++i) {
+        list.push_back(i);
+    }
+    int middle[] = {10, 11, 12};
+    list.insert_range(middle, middle + 3, 2u);
+    auto expected = {0, 1, 10, 11, 12, 2, 3};
+    auto i = 0u;
+    for (auto& value : expected) {
+        ASSERT_EQ(value, list[i]);
+        ++i;
+    }
+    ASSERT_EQ(7u, list.size());
+    ASSERT_THROW(list.insert_range(middle, middle + 3, 8u), std::out_of_range);
+    int full[] = {20, 21, 22, 23};
+    ASSERT_THROW(list.insert_range(full, full + 4, 0u), std::out_of_range);
+    ASSERT_EQ(7u, list.size());
+}
+
+TEST_F(ArrayListTest, EraseRange) {
+    for (auto i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    list.erase_range(2u, 5u);
+    ASSERT_EQ(7u, list.size());
+    auto expected = {0, 1, 5, 6, 7, 8, 9};
+    auto i = 0u;
+    for (auto& value : expected) {
+        ASSERT_EQ(value, list[i]);
+        ++i;
+    }
+    ASSERT_THROW(list.erase_range(5u, 8u), std::out_of_range);
+    list.erase_range(0u, list.size());
+    ASSERT_TRUE(list.empty());
+}
+
+TEST_F(ArrayListTest, RangeNonTrivial) {
+    structures::ArrayList<std::string> strings{2u, 2.0};
+    strings.push_back("a");
+    strings.push_back("e");
+    std::string middle[] = {"b", "c", "d"};
+    strings.insert_range(middle, middle + 3, 1u);
+    ASSERT_EQ(5u, strings.size());
+    ASSERT_EQ("abcde", strings[0] + strings[1] + strings[2] + strings[3] + strings[4]);
+    strings.erase_range(1u, 3u);
+    ASSERT_EQ("ade", strings[0] + strings[1] + strings[2]);
+}
+
+TEST_F(ArrayListTest, SortedSearch) {
+    for (auto i = 0; i < 10; ++i) {
+        list.insert_sorted((i * 7) % 10);
+    }
+    for (auto i = 0u; i < 10u; ++i) {
+        ASSERT_EQ(i, list.find_sorted(i));
+        ASSERT_TRUE(list.contains_sorted(i));
+    }
+    ASSERT_EQ(list.size(), list.find_sorted(10));
+    ASSERT_FALSE(list.contains_sorted(-1));
+}
+
+TEST_F(ArrayListTest, SortedBounds) {
+    ASSERT_EQ(0u, list.lower_bound(1));
+    ASSERT_EQ(0u, list.upper_bound(1));
+
+    auto values = {1, 3, 3, 3, 5, 7};
+    for (auto& value : values) {
+        list.insert_sorted(value);
+    }
+    ASSERT_EQ(0u, list.lower_bound(0));
+    ASSERT_EQ(1u, list.lower_bound(3));
+    ASSERT_EQ(4u, list.upper_bound(3));
+    ASSERT_EQ(4u, list.lower_bound(4));
+    ASSERT_EQ(4u, list.upper_bound(4));
+    ASSERT_EQ(5u, list.upper_bound(5));
+    ASSERT_EQ(6u, list.lower_bound(8));
+    ASSERT_EQ(6u, list.upper_bound(7));
+}
+
+template <typename T>
+void find_all(std::size_t size) {
+    structures::ArrayList<T> values{size};
+    for (auto i = 0u; i < size; ++i) {
+        values.push_back(static_cast<T>(i) * 3);
+    }
+    for (auto i = 0u; i < size; ++i) {
+        ASSERT_EQ(i, values.find(static_cast<T>(i) * 3));
+        ASSERT_TRUE(values.contains(static_cast<T>(i) * 3));
+        ASSERT_FALSE(values.contains(static_cast<T>(i) * 3 + 1));
+    }
+    ASSERT_EQ(size, values.find(static_cast<T>(size) * 3));
+}
+
+TEST_F(ArrayListTest, VectorizedFind) {
+    for (auto size = 0u; size < 40u; ++size) {
+        find_all<int>(size);
+        find_all<unsigned int>(size);
+        find_all<long>(size);
+        find_all<long long>(size);
+        find_all<float>(size);
+        find_all<double>(size);
+        find_all<short>(size);
+    }
+}
+
+TEST_F(ArrayListTest, VectorizedFindFirstMatch) {
+    structures::ArrayList<double> values{21u};
+    for (auto i = 0; i < 20; ++i) {
+        values.push_back(i % 5);
+    }
+    values.push_back(-0.);
+    ASSERT_EQ(3u, values.find(3.));
+    ASSERT_EQ(0u, values.find(0.));
+}
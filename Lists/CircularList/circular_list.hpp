@@ -5,9 +5,11 @@
 #include <cstdint>
 #include <stdexcept>
 
+#include "node_allocator.hpp"
+
 namespace structures {
 
-template<typename T>
+template<typename T, template<typename> class Allocator = NewAllocator>
 /// Classe Lista Circular Simples
 class CircularList {
  public:
@@ -111,29 +113,30 @@ class CircularList {
 
       Node *sentinel;  // Nodo vazio no inicio da lista
       std::size_t size_{0u};
+      Allocator<Node> allocator_;  // alocador de nodos
   };
 
 }  // namespace structures
 
 #endif
 
-template <typename T>
-structures::CircularList<T>::CircularList() {
-	sentinel = new Node();
+template <typename T, template<typename> class Allocator>
+structures::CircularList<T, Allocator>::CircularList() {
+	sentinel = allocator_.create();
 }
 
-template <typename T>
-structures::CircularList<T>::~CircularList() {
+template <typename T, template<typename> class Allocator>
+structures::CircularList<T, Allocator>::~CircularList() {
 	clear();
-	delete sentinel;
+	allocator_.destroy(sentinel);
 }
 
-template <typename T>
-void structures::CircularList<T>::clear() {
+template <typename T, template<typename> class Allocator>
+void structures::CircularList<T, Allocator>::clear() {
 	Node *actual = sentinel->next();
 	for (unsigned int i = 0; i < size_; i++) {
 		Node *aux = actual->next();
-		delete actual;
+		allocator_.destroy(actual);
 		actual = aux;
 	}
 
@@ -141,38 +144,38 @@ void structures::CircularList<T>::clear() {
 	sentinel->next(nullptr);
 }
 
-template <typename T>
-void structures::CircularList<T>::push_back(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::CircularList<T, Allocator>::push_back(const T& data) {
 	insert(data, size_);
 }
 
-template <typename T>
-void structures::CircularList<T>::push_front(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::CircularList<T, Allocator>::push_front(const T& data) {
 	insert(data, 0);
 }
 
-template <typename T>
-void structures::CircularList<T>::insert(const T& data, std::size_t index) {
+template <typename T, template<typename> class Allocator>
+void structures::CircularList<T, Allocator>::insert(const T& data, std::size_t index) {
 	if ((index < 0) || (index > size_))
 		throw std::out_of_range("Invalid index");
 
 	if (index == 0) {
-		sentinel->next(new Node(data, sentinel->next()));
+		sentinel->next(allocator_.create(data, sentinel->next()));
 	} else if (index == size_) {
-		end()->next(new Node(data, sentinel));
+		end()->next(allocator_.create(data, sentinel));
 	} else {
 		Node *actual = sentinel;
 		for (unsigned int i = 0; i < index; i++)
 			actual = actual->next();
 
-		actual->next(new Node(data, actual->next()));
+		actual->next(allocator_.create(data, actual->next()));
 	}
 
 	size_++;
 }
 
-template <typename T>
-void structures::CircularList<T>::insert_sorted(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::CircularList<T, Allocator>::insert_sorted(const T& data) {
 	unsigned int i = 0;
 	if (size_ != 0) {
 		Node *actual = sentinel;
@@ -185,8 +188,8 @@ void structures::CircularList<T>::insert_sorted(const T& data) {
 	insert(data, i);
 }
 
-template <typename T>
-T& structures::CircularList<T>::at(std::size_t index) {
+template <typename T, template<typename> class Allocator>
+T& structures::CircularList<T, Allocator>::at(std::size_t index) {
 	if ((index < 0) || (index >= size_))
 		throw std::out_of_range("Invalid index");
 
@@ -197,8 +200,8 @@ T& structures::CircularList<T>::at(std::size_t index) {
 	return node->data();
 }
 
-template <typename T>
-const T& structures::CircularList<T>::at(std::size_t index) const {
+template <typename T, template<typename> class Allocator>
+const T& structures::CircularList<T, Allocator>::at(std::size_t index) const {
 	if ((index < 0) || (index >= size_))
 		throw std::out_of_range("Invalid index");
 
@@ -209,8 +212,8 @@ const T& structures::CircularList<T>::at(std::size_t index) const {
 	return node->data();
 }
 
-template <typename T>
-T structures::CircularList<T>::pop(std::size_t index) {
+template <typename T, template<typename> class Allocator>
+T structures::CircularList<T, Allocator>::pop(std::size_t index) {
 	if (empty())
 		throw std::out_of_range("Empty list");
 	if ((index < 0) || (index >= size_))
@@ -223,35 +226,35 @@ T structures::CircularList<T>::pop(std::size_t index) {
 	Node *node = actual->next();
 	T data = node->data();
 	actual->next(node->next());
-	delete node;
+	allocator_.destroy(node);
 
 	size_--;
 	return data;
 }
 
-template <typename T>
-T structures::CircularList<T>::pop_back() {
+template <typename T, template<typename> class Allocator>
+T structures::CircularList<T, Allocator>::pop_back() {
 	return pop(size_ - 1);
 }
 
-template <typename T>
-T structures::CircularList<T>::pop_front() {
+template <typename T, template<typename> class Allocator>
+T structures::CircularList<T, Allocator>::pop_front() {
 	return pop(0);
 }
 
-template <typename T>
-void structures::CircularList<T>::remove(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::CircularList<T, Allocator>::remove(const T& data) {
 	if (contains(data))
 		pop(find(data));
 }
 
-template <typename T>
-bool structures::CircularList<T>::empty() const {
+template <typename T, template<typename> class Allocator>
+bool structures::CircularList<T, Allocator>::empty() const {
 	return size_ == 0;
 }
 
-template <typename T>
-bool structures::CircularList<T>::contains(const T& data) const {
+template <typename T, template<typename> class Allocator>
+bool structures::CircularList<T, Allocator>::contains(const T& data) const {
 	Node *actual = sentinel->next();
 	for (unsigned int i = 0; i < size_; i++) {
 		if (data == actual->data())
@@ -263,8 +266,8 @@ bool structures::CircularList<T>::contains(const T& data) const {
 	return false;
 }
 
-template <typename T>
-std::size_t structures::CircularList<T>::find(const T& data) const {
+template <typename T, template<typename> class Allocator>
+std::size_t structures::CircularList<T, Allocator>::find(const T& data) const {
 	if (!contains(data)) {
 		return size_;
 	} else {
@@ -279,7 +282,7 @@ std::size_t structures::CircularList<T>::find(const T& data) const {
 	}
 }
 
-template <typename T>
-std::size_t structures::CircularList<T>::size() const {
+template <typename T, template<typename> class Allocator>
+std::size_t structures::CircularList<T, Allocator>::size() const {
 	return size_;
 }
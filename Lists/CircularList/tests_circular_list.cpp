@@ -215,3 +215,18 @@ TEST_F(CircularListTest, RemoveElement) {
     ASSERT_EQ(9u, list.size());
     ASSERT_FALSE(list.contains(4));
 }
+
+TEST_F(CircularListTest, PoolAllocator) {
+    structures::CircularList<int, structures::PoolAllocator> pooled{};
+    for (auto round = 0; round < 10; ++round) {
+        for (auto i = 0; i < 100; ++i) {
+            pooled.push_back(i);
+        }
+        ASSERT_EQ(100u, pooled.size());
+        for (auto i = 0; i < 100; ++i) {
+            ASSERT_EQ(i, pooled.pop_front());
+        }
+        ASSERT_TRUE(pooled.empty());
+    }
+    pooled.push_back(1);
+}
@@ -3,14 +3,27 @@
 #define STRUCTURES_DOUBLY_CIRCULAR_LIST_H
 
 #include <cstdint>
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
+
+#include "node_allocator.hpp"
 
 namespace structures {
 
-template<typename T>
+template<typename T, template<typename> class Allocator = NewAllocator>
 /// Lista duplamente encadeada
 class DoublyCircularList {
+    class Node;
+
+    template<bool Const>
+    class Iterator;
+
   public:
+    /// Iteradores bidirecionais; end() e' o nodo sentinela
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
     DoublyCircularList();
 
     ~DoublyCircularList();
@@ -60,24 +73,44 @@ class DoublyCircularList {
     /// tamanho
     std::size_t size() const;
 
+    /// iterador para o primeiro elemento
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+
+    /// iterador para o sentinela (depois do último elemento)
+    iterator end();
+    const_iterator end() const;
+    const_iterator cend() const;
+
+    /// insere antes da posição do iterador, em O(1)
+    iterator insert_before(const_iterator position, const T& data);
+
+    /// retira o elemento na posição do iterador, em O(1); retorna o seguinte
+    iterator erase(const_iterator position);
+
+    /// move o elemento it de other para antes de position, em O(1)
+    void splice(const_iterator position, DoublyCircularList& other,
+                const_iterator it);
+
   private:
     class Node {
       public:
-        Node() {
-            data_ = 0;
-        }
-        explicit Node(const T& data) {
-            data_ = data;
-        }
-        Node(const T& data, Node* next) {
-            data_ = data;
-            next_ = next;
-        }
-        Node(const T& data, Node* prev, Node* next) {
-            data_ = data;
-            prev_ = prev;
-            next_ = next;
-        }
+        Node():  // sentinela
+            data_{}
+        {}
+        explicit Node(const T& data):
+            data_{data}
+        {}
+        Node(const T& data, Node* next):
+            data_{data},
+            next_{next}
+        {}
+        Node(const T& data, Node* prev, Node* next):
+            data_{data},
+            prev_{prev},
+            next_{next}
+        {}
 
         T& data() {
             return data_;
@@ -112,61 +145,137 @@ class DoublyCircularList {
         }
 
       private:
-            T data_;
-            Node* prev_{nullptr};
-            Node* next_{nullptr};
-        };
+        T data_;
+        Node* prev_{nullptr};
+        Node* next_{nullptr};
+    };
+
+    template<bool Const>
+    class Iterator {  /// Iterador sobre os nodos
+      public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<Const, const T*, T*>::type pointer;
+        typedef typename std::conditional<Const, const T&, T&>::type reference;
+
+        Iterator() = default;
+
+        explicit Iterator(Node* node):
+            node_{node}
+        {}
+
+        Iterator(const Iterator<false>& other):  // iterator -> const_iterator
+            node_{other.node_}
+        {}
+
+        /// O construtor acima e' o de copia quando Const e' falso
+        Iterator& operator=(const Iterator&) = default;
+
+        reference operator*() const {
+            return node_->data();
+        }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            node_ = node_->next();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old{*this};
+            node_ = node_->next();
+            return old;
+        }
+
+        Iterator& operator--() {
+            node_ = node_->prev();
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator old{*this};
+            node_ = node_->prev();
+            return old;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            return a.node_ == b.node_;
+        }
+
+        friend bool operator!=(const Iterator& a, const Iterator& b) {
+            return a.node_ != b.node_;
+        }
 
-        Node* head;  // sentinela
-        std::size_t size_{0u};
+      private:
+        friend class DoublyCircularList;
+        friend class Iterator<true>;
+
+        Node* node_{nullptr};
     };
 
+    /// Desliga o nodo da lista, sem libera-lo
+    static void unlink(Node* node);
+
+    /// Liga o nodo antes de position
+    static void link_before(Node* position, Node* node);
+
+    Node* head;  // sentinela: ligado a si mesmo quando a lista esta vazia
+    std::size_t size_{0u};
+    Allocator<Node> allocator_;  // alocador de nodos
+};
+
 }  // namespace structures
 
 #endif
 
-template <typename T>
-structures::DoublyCircularList<T>::DoublyCircularList() {
-    head = new Node();
+template <typename T, template<typename> class Allocator>
+structures::DoublyCircularList<T, Allocator>::DoublyCircularList() {
+    head = allocator_.create();
+    head->next(head);
+    head->prev(head);
 }
 
-template <typename T>
-structures::DoublyCircularList<T>::~DoublyCircularList() {
+template <typename T, template<typename> class Allocator>
+structures::DoublyCircularList<T, Allocator>::~DoublyCircularList() {
     clear();
-    delete head;
+    allocator_.destroy(head);
 }
 
-template <typename T>
-void structures::DoublyCircularList<T>::clear() {
+template <typename T, template<typename> class Allocator>
+void structures::DoublyCircularList<T, Allocator>::clear() {
     while (!empty()) {
         Node *actual = head->next();
         head->next(actual->next());
-        delete actual;
+        allocator_.destroy(actual);
         size_--;
     }
 
-    head->next(nullptr);
-    head->prev(nullptr);
+    head->next(head);
+    head->prev(head);
 }
 
-template <typename T>
-void structures::DoublyCircularList<T>::push_back(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::DoublyCircularList<T, Allocator>::push_back(const T& data) {
     insert(data, size_);
 }
 
-template <typename T>
-void structures::DoublyCircularList<T>::push_front(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::DoublyCircularList<T, Allocator>::push_front(const T& data) {
     insert(data, 0);
 }
 
-template <typename T>
-void structures::DoublyCircularList<T>::insert(const T& data, std::size_t index) {
+template <typename T, template<typename> class Allocator>
+void structures::DoublyCircularList<T, Allocator>::insert(const T& data, std::size_t index) {
     if ((index < 0) || (index > size_))
     	throw std::out_of_range("Invalid index");
 
     Node *new_node;
     if (size_ == 0) {
-        new_node = new Node(data, head, head);
+        new_node = allocator_.create(data, head, head);
         head->prev(new_node);
         head->next(new_node);
     } else {
@@ -180,7 +289,7 @@ void structures::DoublyCircularList<T>::insert(const T& data, std::size_t index)
                 actual = actual->prev();
             }
         }
-        new_node = new Node(data, actual, actual->next());
+        new_node = allocator_.create(data, actual, actual->next());
         actual->next()->prev(new_node);
         actual->next(new_node);
     }
@@ -188,8 +297,8 @@ void structures::DoublyCircularList<T>::insert(const T& data, std::size_t index)
     size_++;
 }
 
-template <typename T>
-void structures::DoublyCircularList<T>::insert_sorted(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::DoublyCircularList<T, Allocator>::insert_sorted(const T& data) {
     unsigned int i = 0;
     if (size_ != 0) {
         Node *actual = head;
@@ -202,8 +311,8 @@ void structures::DoublyCircularList<T>::insert_sorted(const T& data) {
     insert(data, i);
 }
 
-template <typename T>
-T structures::DoublyCircularList<T>::pop(std::size_t index) {
+template <typename T, template<typename> class Allocator>
+T structures::DoublyCircularList<T, Allocator>::pop(std::size_t index) {
     if (empty())
     	throw std::out_of_range("Empty list");
     if ((index < 0) || (index >= size_))
@@ -219,43 +328,37 @@ T structures::DoublyCircularList<T>::pop(std::size_t index) {
     }
 
     /// Acerto dos ponteiros
-    if (size_ > 1) {
-        node->prev()->next(node->next());
-        node->next()->prev(node->prev());
-    } else {
-        head->next(nullptr);
-        head->prev(nullptr);
-    }
+    unlink(node);
 
     T data = node->data();
-    delete node;
+    allocator_.destroy(node);
     size_--;
     return data;
 }
 
-template <typename T>
-T structures::DoublyCircularList<T>::pop_back() {
+template <typename T, template<typename> class Allocator>
+T structures::DoublyCircularList<T, Allocator>::pop_back() {
     return pop(size_ - 1);
 }
 
-template <typename T>
-T structures::DoublyCircularList<T>::pop_front() {
+template <typename T, template<typename> class Allocator>
+T structures::DoublyCircularList<T, Allocator>::pop_front() {
     return pop(0);
 }
 
-template <typename T>
-void structures::DoublyCircularList<T>::remove(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::DoublyCircularList<T, Allocator>::remove(const T& data) {
     if (contains(data))
     	pop(find(data));
 }
 
-template <typename T>
-bool structures::DoublyCircularList<T>::empty() const {
+template <typename T, template<typename> class Allocator>
+bool structures::DoublyCircularList<T, Allocator>::empty() const {
     return size_ == 0;
 }
 
-template <typename T>
-bool structures::DoublyCircularList<T>::contains(const T& data) const {
+template <typename T, template<typename> class Allocator>
+bool structures::DoublyCircularList<T, Allocator>::contains(const T& data) const {
     Node *actual = head->next();
     for (unsigned int i = 0; i < size_; i++) {
         if (data == actual->data())
@@ -267,8 +370,8 @@ bool structures::DoublyCircularList<T>::contains(const T& data) const {
     return false;
 }
 
-template <typename T>
-T& structures::DoublyCircularList<T>::at(std::size_t index) {
+template <typename T, template<typename> class Allocator>
+T& structures::DoublyCircularList<T, Allocator>::at(std::size_t index) {
     if ((index < 0) || (index >= size_))
     	throw std::out_of_range("Invalid index");
 
@@ -286,8 +389,8 @@ T& structures::DoublyCircularList<T>::at(std::size_t index) {
     return node->data();
 }
 
-template <typename T>
-const T& structures::DoublyCircularList<T>::at(std::size_t index) const {
+template <typename T, template<typename> class Allocator>
+const T& structures::DoublyCircularList<T, Allocator>::at(std::size_t index) const {
     if ((index < 0) || (index >= size_))
     	throw std::out_of_range("Invalid index");
 
@@ -305,8 +408,8 @@ const T& structures::DoublyCircularList<T>::at(std::size_t index) const {
     return node->data();
 }
 
-template <typename T>
-std::size_t structures::DoublyCircularList<T>::find(const T& data) const {
+template <typename T, template<typename> class Allocator>
+std::size_t structures::DoublyCircularList<T, Allocator>::find(const T& data) const {
     if (!contains(data)) {
         return size_;
     } else {
@@ -321,7 +424,104 @@ std::size_t structures::DoublyCircularList<T>::find(const T& data) const {
     }
 }
 
-template <typename T>
-std::size_t structures::DoublyCircularList<T>::size() const {
+template <typename T, template<typename> class Allocator>
+std::size_t structures::DoublyCircularList<T, Allocator>::size() const {
     return size_;
 }
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyCircularList<T, Allocator>::iterator
+structures::DoublyCircularList<T, Allocator>::begin() {
+    return iterator{head->next()};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyCircularList<T, Allocator>::const_iterator
+structures::DoublyCircularList<T, Allocator>::begin() const {
+    return const_iterator{head->next()};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyCircularList<T, Allocator>::const_iterator
+structures::DoublyCircularList<T, Allocator>::cbegin() const {
+    return const_iterator{head->next()};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyCircularList<T, Allocator>::iterator
+structures::DoublyCircularList<T, Allocator>::end() {
+    return iterator{head};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyCircularList<T, Allocator>::const_iterator
+structures::DoublyCircularList<T, Allocator>::end() const {
+    return const_iterator{head};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyCircularList<T, Allocator>::const_iterator
+structures::DoublyCircularList<T, Allocator>::cend() const {
+    return const_iterator{head};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyCircularList<T, Allocator>::iterator
+structures::DoublyCircularList<T, Allocator>::insert_before(
+    const_iterator position, const T& data) {
+    Node *node = allocator_.create(data);
+    link_before(position.node_, node);
+    size_++;
+    return iterator{node};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyCircularList<T, Allocator>::iterator
+structures::DoublyCircularList<T, Allocator>::erase(const_iterator position) {
+    Node *node = position.node_;
+    if (node == head)
+        throw std::out_of_range("Invalid iterator");
+
+    Node *next = node->next();
+    unlink(node);
+    allocator_.destroy(node);
+    size_--;
+    return iterator{next};
+}
+
+template <typename T, template<typename> class Allocator>
+void structures::DoublyCircularList<T, Allocator>::splice(
+    const_iterator position, DoublyCircularList& other, const_iterator it) {
+    Node *node = it.node_;
+    if (node == other.head)
+        throw std::out_of_range("Invalid iterator");
+    if ((node == position.node_) || (node->next() == position.node_))
+        return;  // ja esta antes de position
+
+    if (allocator_ != other.allocator_) {
+        /// Nodos de outro pool nao podem ser liberados por este alocador
+        insert_before(position, *it);
+        other.erase(it);
+        return;
+    }
+
+    unlink(node);
+    link_before(position.node_, node);
+    other.size_--;
+    size_++;
+}
+
+template <typename T, template<typename> class Allocator>
+void structures::DoublyCircularList<T, Allocator>::unlink(Node* node) {
+    node->prev()->next(node->next());
+    node->next()->prev(node->prev());
+}
+
+template <typename T, template<typename> class Allocator>
+void structures::DoublyCircularList<T, Allocator>::link_before(Node* position,
+                                                               Node* node) {
+    node->prev(position->prev());
+    node->next(position);
+    position->prev()->next(node);
+    position->prev(node);
+}
@@ -1,4 +1,8 @@
 // Copyright 2016 João Paulo Taylor Ienczak Zanette
+#include <iterator>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "doubly_circular_list.hpp"
 
@@ -214,3 +218,84 @@ TEST_F(DoublyCircularListTest, RemoveElement) {
     ASSERT_EQ(9u, list.size());
     ASSERT_FALSE(list.contains(4));
 }
+
+TEST_F(DoublyCircularListTest, PoolAllocator) {
+    structures::DoublyCircularList<int, structures::PoolAllocator> pooled{};
+    for (auto round = 0; round < 10; ++round) {
+        for (auto i = 0; i < 100; ++i) {
+            pooled.push_front(i);
+        }
+        ASSERT_EQ(100u, pooled.size());
+        for (auto i = 0; i < 100; ++i) {
+            ASSERT_EQ(i, pooled.pop_back());
+        }
+        ASSERT_TRUE(pooled.empty());
+    }
+    pooled.push_front(1);
+}
+
+TEST_F(DoublyCircularListTest, Iteration) {
+    ASSERT_TRUE(list.begin() == list.end());
+    for (auto i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    auto expected = 0;
+    for (auto data : list) {
+        ASSERT_EQ(expected++, data);
+    }
+    ASSERT_EQ(9, *std::prev(list.end()));
+    ASSERT_TRUE(std::next(list.end()) == list.begin());
+    list.clear();
+    ASSERT_TRUE(list.cbegin() == list.cend());
+    list.push_back(1);
+    ASSERT_EQ(1, *list.begin());
+}
+
+TEST_F(DoublyCircularListTest, InsertBeforeAndErase) {
+    ASSERT_THROW(list.erase(list.end()), std::out_of_range);
+    auto it = list.insert_before(list.end(), 2);
+    list.insert_before(it, 0);
+    list.insert_before(it, 1);
+    list.insert_before(list.end(), 3);
+    ASSERT_EQ(4u, list.size());
+    for (auto i = 0; i < 4; ++i) {
+        ASSERT_EQ(i, list.at(i));
+    }
+    it = list.erase(it);
+    ASSERT_EQ(3, *it);
+    it = list.erase(it);
+    ASSERT_TRUE(it == list.end());
+    ASSERT_EQ(1, list.pop_back());
+    ASSERT_EQ(0, list.pop_back());
+    ASSERT_TRUE(list.empty());
+}
+
+TEST_F(DoublyCircularListTest, SpliceElement) {
+    for (auto i = 0; i < 5; ++i) {
+        list.push_back(i);
+    }
+    list.splice(list.begin(), list, std::prev(list.end()));  // 4 na frente
+    list.splice(list.begin(), list, list.begin());
+    list.splice(list.end(), list, std::prev(list.end()));
+    ASSERT_EQ((std::vector<int>{4, 0, 1, 2, 3}),
+              std::vector<int>(list.begin(), list.end()));
+
+    structures::DoublyCircularList<int> other{};
+    other.push_back(10);
+    list.splice(list.end(), other, other.begin());
+    ASSERT_TRUE(other.empty());
+    ASSERT_EQ(6u, list.size());
+    ASSERT_EQ(10, list.pop_back());
+    ASSERT_THROW(list.splice(list.end(), other, other.end()),
+                 std::out_of_range);
+}
+
+TEST_F(DoublyCircularListTest, NonNumericData) {
+    structures::DoublyCircularList<std::string> strings{};
+    strings.push_back("b");
+    strings.push_front("a");
+    strings.insert_before(strings.end(), "c");
+    ASSERT_EQ("abc", std::string(strings.at(0) + strings.at(1) +
+                                 strings.at(2)));
+    ASSERT_EQ("c", strings.pop_back());
+}
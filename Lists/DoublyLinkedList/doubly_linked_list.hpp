@@ -3,16 +3,32 @@
 #define STRUCTURES_DOUBLY_LINKED_LIST_H
 
 #include <cstdint>
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
+
+#include "node_allocator.hpp"
 
 namespace structures {
 
-template<typename T>
+template<typename T, template<typename> class Allocator = NewAllocator>
 /// Classe Lista Duplamente Encadeada
 class DoublyLinkedList {
+    class Node;
+
+    template<bool Const>
+    class Iterator;
+
  public:
+    /// Iteradores bidirecionais
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
     DoublyLinkedList();
 
+    /// Construtor com um alocador (ex.: copia do alocador de outra lista)
+    explicit DoublyLinkedList(const Allocator<Node>& allocator);
+
     ~DoublyLinkedList();
 
     /// Limpar
@@ -60,23 +76,50 @@ class DoublyLinkedList {
     /// tamanho
     std::size_t size() const;
 
+    /// alocador de nodos da lista
+    Allocator<Node> allocator() const;
+
+    /// iterador para o primeiro elemento
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+
+    /// iterador para depois do último elemento
+    iterator end();
+    const_iterator end() const;
+    const_iterator cend() const;
+
+    /// insere antes da posição do iterador, em O(1)
+    iterator insert_before(const_iterator position, const T& data);
+
+    /// retira o elemento na posição do iterador, em O(1); retorna o seguinte
+    iterator erase(const_iterator position);
+
+    /// move todos os elementos de other para antes de position, em O(1)
+    void splice(const_iterator position, DoublyLinkedList& other);
+
+    /// move [first, last) de other para antes de position; O(1) dentro da
+    /// mesma lista, O(last - first) entre listas (contagem do tamanho)
+    void splice(const_iterator position, DoublyLinkedList& other,
+                const_iterator first, const_iterator last);
+
  private:
     class Node {
       public:
-        explicit Node(const T& data) {
-            data_ = data;
-        }
+        explicit Node(const T& data):
+            data_{data}
+        {}
 
-        Node(const T& data, Node* next) {
-            data_ = data;
-            next_ = next;
-        }
+        Node(const T& data, Node* next):
+            data_{data},
+            next_{next}
+        {}
 
-        Node(const T& data, Node* prev, Node* next) {
-            data_ = data;
-            prev_ = prev;
-            next_ = next;
-        }
+        Node(const T& data, Node* prev, Node* next):
+            data_{data},
+            prev_{prev},
+            next_{next}
+        {}
 
         T& data() {
             return data_;
@@ -116,31 +159,114 @@ class DoublyLinkedList {
         Node* next_{nullptr};
     };
 
+    template<bool Const>
+    class Iterator {  /// Iterador sobre os nodos
+     public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<Const, const T*, T*>::type pointer;
+        typedef typename std::conditional<Const, const T&, T&>::type reference;
+
+        Iterator() = default;
+
+        Iterator(Node* node, const DoublyLinkedList* list):
+            node_{node},
+            list_{list}
+        {}
+
+        Iterator(const Iterator<false>& other):  // iterator -> const_iterator
+            node_{other.node_},
+            list_{other.list_}
+        {}
+
+        /// O construtor acima e' o de copia quando Const e' falso
+        Iterator& operator=(const Iterator&) = default;
+
+        reference operator*() const {
+            return node_->data();
+        }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            node_ = node_->next();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old{*this};
+            node_ = node_->next();
+            return old;
+        }
+
+        Iterator& operator--() {  // end() volta ao último nodo
+            node_ = (node_ == nullptr) ? list_->tail : node_->prev();
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator old{*this};
+            --*this;
+            return old;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            return a.node_ == b.node_;
+        }
+
+        friend bool operator!=(const Iterator& a, const Iterator& b) {
+            return a.node_ != b.node_;
+        }
+
+     private:
+        friend class DoublyLinkedList;
+        friend class Iterator<true>;
+
+        Node* node_{nullptr};
+        const DoublyLinkedList* list_{nullptr};
+    };
+
+    /// Desliga o nodo da lista, sem libera-lo
+    void unlink(Node* node);
+
+    /// Liga os nodos [first, last] antes de position (nullptr: no fim)
+    void link_before(Node* position, Node* first, Node* last);
+
     Node* head{nullptr};
     Node* tail{nullptr};
     std::size_t size_{0u};
+    Allocator<Node> allocator_;  // alocador de nodos
 };
 
 }  /// namespace structures
 
 #endif
 
-template <typename T>
-structures::DoublyLinkedList<T>::DoublyLinkedList() {
+template <typename T, template<typename> class Allocator>
+structures::DoublyLinkedList<T, Allocator>::DoublyLinkedList() {
     /// Empty constructor
 }
 
-template <typename T>
-structures::DoublyLinkedList<T>::~DoublyLinkedList() {
+template <typename T, template<typename> class Allocator>
+structures::DoublyLinkedList<T, Allocator>::DoublyLinkedList(
+    const Allocator<Node>& allocator):
+    allocator_{allocator}
+{}
+
+template <typename T, template<typename> class Allocator>
+structures::DoublyLinkedList<T, Allocator>::~DoublyLinkedList() {
     clear();
 }
 
-template <typename T>
-void structures::DoublyLinkedList<T>::clear() {
+template <typename T, template<typename> class Allocator>
+void structures::DoublyLinkedList<T, Allocator>::clear() {
     Node *aux = head;
     for (unsigned int i = 0; i < size_; i++) {
         Node *next = aux->next();
-        delete aux;
+        allocator_.destroy(aux);
         aux = next;
     }
 
@@ -149,34 +275,34 @@ void structures::DoublyLinkedList<T>::clear() {
     size_ = 0;
 }
 
-template <typename T>
-void structures::DoublyLinkedList<T>::push_back(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::DoublyLinkedList<T, Allocator>::push_back(const T& data) {
     insert(data, size_);
 }
 
-template <typename T>
-void structures::DoublyLinkedList<T>::push_front(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::DoublyLinkedList<T, Allocator>::push_front(const T& data) {
     insert(data, 0);
 }
 
-template <typename T>
-void structures::DoublyLinkedList<T>::insert(const T& data, std::size_t index) {
+template <typename T, template<typename> class Allocator>
+void structures::DoublyLinkedList<T, Allocator>::insert(const T& data, std::size_t index) {
     if ((index > size_) || (index < 0))
         throw std::out_of_range("Invalid index");
 
     Node *new_node;
     if (empty()) {
-        new_node = new Node(data);
+        new_node = allocator_.create(data);
         head = new_node;
         tail = new_node;
     } else {
         Node *aux;  /// Nodo no indice a ser trabalhado
         if (index == size_) {
-            new_node = new Node(data, tail, nullptr);
+            new_node = allocator_.create(data, tail, nullptr);
             tail->next(new_node);
             tail = new_node;
         } else if (index == 0) {
-            new_node = new Node(data, head);
+            new_node = allocator_.create(data, head);
             head->prev(new_node);
             head = new_node;
         } else {
@@ -189,7 +315,7 @@ void structures::DoublyLinkedList<T>::insert(const T& data, std::size_t index) {
                 for (unsigned int i = 0; i < (size_ - index - 1); i++)
                     aux = aux->prev();
             }
-            new_node = new Node(data, aux->prev(), aux);
+            new_node = allocator_.create(data, aux->prev(), aux);
             aux->prev()->next(new_node);
             aux->prev(new_node);
         }
@@ -198,8 +324,8 @@ void structures::DoublyLinkedList<T>::insert(const T& data, std::size_t index) {
     size_++;
 }
 
-template <typename T>
-void structures::DoublyLinkedList<T>::insert_sorted(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::DoublyLinkedList<T, Allocator>::insert_sorted(const T& data) {
     unsigned int i = 0;
     if (!empty()) {
         Node *actual = head;
@@ -212,8 +338,8 @@ void structures::DoublyLinkedList<T>::insert_sorted(const T& data) {
     insert(data, i);
 }
 
-template <typename T>
-T structures::DoublyLinkedList<T>::pop(std::size_t index) {
+template <typename T, template<typename> class Allocator>
+T structures::DoublyLinkedList<T, Allocator>::pop(std::size_t index) {
     if (empty())
         throw std::out_of_range("Empty list");
 
@@ -252,34 +378,34 @@ T structures::DoublyLinkedList<T>::pop(std::size_t index) {
     }
 
     /// Remoção do node
-    delete node;
+    allocator_.destroy(node);
     size_--;
     return node_data;
 }
 
-template <typename T>
-T structures::DoublyLinkedList<T>::pop_back() {
+template <typename T, template<typename> class Allocator>
+T structures::DoublyLinkedList<T, Allocator>::pop_back() {
     return pop(size_ - 1);
 }
 
-template <typename T>
-T structures::DoublyLinkedList<T>::pop_front() {
+template <typename T, template<typename> class Allocator>
+T structures::DoublyLinkedList<T, Allocator>::pop_front() {
     return pop(0);
 }
 
-template <typename T>
-void structures::DoublyLinkedList<T>::remove(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::DoublyLinkedList<T, Allocator>::remove(const T& data) {
     if (contains(data))
         pop(find(data));
 }
 
-template <typename T>
-bool structures::DoublyLinkedList<T>::empty() const {
+template <typename T, template<typename> class Allocator>
+bool structures::DoublyLinkedList<T, Allocator>::empty() const {
     return size_ == 0;
 }
 
-template <typename T>
-bool structures::DoublyLinkedList<T>::contains(const T& data) const {
+template <typename T, template<typename> class Allocator>
+bool structures::DoublyLinkedList<T, Allocator>::contains(const T& data) const {
     if (empty())
         throw std::out_of_range("Empty list");
 
@@ -293,8 +419,8 @@ bool structures::DoublyLinkedList<T>::contains(const T& data) const {
     return false;
 }
 
-template <typename T>
-T& structures::DoublyLinkedList<T>::at(std::size_t index) {
+template <typename T, template<typename> class Allocator>
+T& structures::DoublyLinkedList<T, Allocator>::at(std::size_t index) {
     if (empty())
         throw std::out_of_range("Empty list");
     if ((index >= size_) || (index < 0))
@@ -314,8 +440,8 @@ T& structures::DoublyLinkedList<T>::at(std::size_t index) {
     return actual->data();
 }
 
-template <typename T>
-const T& structures::DoublyLinkedList<T>::at(std::size_t index) const {
+template <typename T, template<typename> class Allocator>
+const T& structures::DoublyLinkedList<T, Allocator>::at(std::size_t index) const {
     if (empty())
         throw std::out_of_range("Empty list");
     if ((index >= size_) || (index < 0))
@@ -335,8 +461,8 @@ const T& structures::DoublyLinkedList<T>::at(std::size_t index) const {
     return actual->data();
 }
 
-template <typename T>
-std::size_t structures::DoublyLinkedList<T>::find(const T& data) const {
+template <typename T, template<typename> class Allocator>
+std::size_t structures::DoublyLinkedList<T, Allocator>::find(const T& data) const {
     if (empty())
         throw std::out_of_range("Empty list");
 
@@ -350,7 +476,166 @@ std::size_t structures::DoublyLinkedList<T>::find(const T& data) const {
     return i;
 }
 
-template <typename T>
-std::size_t structures::DoublyLinkedList<T>::size() const {
+template <typename T, template<typename> class Allocator>
+std::size_t structures::DoublyLinkedList<T, Allocator>::size() const {
     return size_;
 }
+
+template <typename T, template<typename> class Allocator>
+Allocator<typename structures::DoublyLinkedList<T, Allocator>::Node>
+structures::DoublyLinkedList<T, Allocator>::allocator() const {
+    return allocator_;
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::iterator
+structures::DoublyLinkedList<T, Allocator>::begin() {
+    return iterator{head, this};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::const_iterator
+structures::DoublyLinkedList<T, Allocator>::begin() const {
+    return const_iterator{head, this};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::const_iterator
+structures::DoublyLinkedList<T, Allocator>::cbegin() const {
+    return const_iterator{head, this};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::iterator
+structures::DoublyLinkedList<T, Allocator>::end() {
+    return iterator{nullptr, this};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::const_iterator
+structures::DoublyLinkedList<T, Allocator>::end() const {
+    return const_iterator{nullptr, this};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::const_iterator
+structures::DoublyLinkedList<T, Allocator>::cend() const {
+    return const_iterator{nullptr, this};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::iterator
+structures::DoublyLinkedList<T, Allocator>::insert_before(
+    const_iterator position, const T& data) {
+    Node *node = allocator_.create(data);
+    link_before(position.node_, node, node);
+    size_++;
+    return iterator{node, this};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::iterator
+structures::DoublyLinkedList<T, Allocator>::erase(const_iterator position) {
+    Node *node = position.node_;
+    if (node == nullptr)
+        throw std::out_of_range("Invalid iterator");
+
+    Node *next = node->next();
+    unlink(node);
+    allocator_.destroy(node);
+    size_--;
+    return iterator{next, this};
+}
+
+template <typename T, template<typename> class Allocator>
+void structures::DoublyLinkedList<T, Allocator>::splice(
+    const_iterator position, DoublyLinkedList& other) {
+    if ((&other == this) || other.empty())
+        return;
+
+    if (allocator_ != other.allocator_) {
+        splice(position, other, other.cbegin(), other.cend());
+        return;
+    }
+
+    link_before(position.node_, other.head, other.tail);
+    size_ += other.size_;
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size_ = 0;
+}
+
+template <typename T, template<typename> class Allocator>
+void structures::DoublyLinkedList<T, Allocator>::splice(
+    const_iterator position, DoublyLinkedList& other,
+    const_iterator first, const_iterator last) {
+    if (first == last)
+        return;
+    if ((&other == this) && ((position == first) || (position == last)))
+        return;  // o intervalo ja esta antes de position
+
+    if (allocator_ != other.allocator_) {
+        /// Nodos de outro pool nao podem ser liberados por este alocador:
+        /// copia os dados e os retira de other
+        while (first != last) {
+            insert_before(position, *first);
+            first = other.erase(first);
+        }
+        return;
+    }
+
+    Node *first_node = first.node_;
+    Node *last_node = (last.node_ == nullptr) ? other.tail : last.node_->prev();
+
+    if (&other != this) {
+        std::size_t count = 1;
+        for (Node *node = first_node; node != last_node; node = node->next())
+            count++;
+        other.size_ -= count;
+        size_ += count;
+    }
+
+    /// Desliga o intervalo de other
+    if (first_node->prev() == nullptr)
+        other.head = last_node->next();
+    else
+        first_node->prev()->next(last_node->next());
+    if (last_node->next() == nullptr)
+        other.tail = first_node->prev();
+    else
+        last_node->next()->prev(first_node->prev());
+
+    link_before(position.node_, first_node, last_node);
+}
+
+template <typename T, template<typename> class Allocator>
+void structures::DoublyLinkedList<T, Allocator>::unlink(Node* node) {
+    if (node->prev() == nullptr)
+        head = node->next();
+    else
+        node->prev()->next(node->next());
+
+    if (node->next() == nullptr)
+        tail = node->prev();
+    else
+        node->next()->prev(node->prev());
+}
+
+template <typename T, template<typename> class Allocator>
+void structures::DoublyLinkedList<T, Allocator>::link_before(Node* position,
+                                                             Node* first,
+                                                             Node* last) {
+    Node *prev = (position == nullptr) ? tail : position->prev();
+    first->prev(prev);
+    last->next(position);
+
+    if (prev == nullptr)
+        head = first;
+    else
+        prev->next(first);
+
+    if (position == nullptr)
+        tail = last;
+    else
+        position->prev(last);
+}
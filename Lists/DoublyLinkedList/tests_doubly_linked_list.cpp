@@ -1,3 +1,7 @@
+#include <iterator>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "doubly_linked_list.hpp"
 
@@ -207,3 +211,145 @@ TEST_F(DoublyLinkedListTest, RemoveElement) {
     ASSERT_EQ(9u, list.size());
     ASSERT_FALSE(list.contains(4));
 }
+
+TEST_F(DoublyLinkedListTest, PoolAllocator) {
+    structures::DoublyLinkedList<int, structures::PoolAllocator> pooled{};
+    for (auto round = 0; round < 10; ++round) {
+        for (auto i = 0; i < 100; ++i) {
+            pooled.push_back(i);
+        }
+        ASSERT_EQ(100u, pooled.size());
+        for (auto i = 0; i < 100; ++i) {
+            ASSERT_EQ(i, pooled.pop_front());
+        }
+        ASSERT_TRUE(pooled.empty());
+    }
+    pooled.push_back(1);
+}
+
+template<typename List>
+std::vector<int> contents(const List& list) {
+    return std::vector<int>(list.begin(), list.end());
+}
+
+TEST_F(DoublyLinkedListTest, BidirectionalIteration) {
+    ASSERT_TRUE(list.begin() == list.end());
+    for (auto i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    auto expected = 0;
+    for (auto& data : list) {
+        ASSERT_EQ(expected++, data);
+    }
+    auto it = list.end();
+    for (auto i = 9; i >= 0; --i) {
+        ASSERT_EQ(i, *--it);
+    }
+    ASSERT_TRUE(it == list.begin());
+    const auto& const_list = list;
+    typedef std::reverse_iterator<
+        structures::DoublyLinkedList<int>::const_iterator> reverse_iterator;
+    std::vector<int> reversed(reverse_iterator{const_list.end()},
+                              reverse_iterator{const_list.begin()});
+    ASSERT_EQ(9, reversed.front());
+    ASSERT_EQ(0, reversed.back());
+}
+
+TEST_F(DoublyLinkedListTest, InsertBefore) {
+    auto it = list.insert_before(list.end(), 5);
+    list.insert_before(it, 0);
+    list.insert_before(list.end(), 9);
+    it = list.begin();
+    ++it;
+    for (auto i = 1; i < 5; ++i) {
+        list.insert_before(it, i);
+    }
+    ++it;
+    for (auto i = 6; i < 9; ++i) {
+        list.insert_before(it, i);
+    }
+    ASSERT_EQ(10u, list.size());
+    for (auto i = 0; i < 10; ++i) {
+        ASSERT_EQ(i, list.at(i));
+    }
+    list.push_back(10);
+    list.push_front(-1);
+    ASSERT_EQ(10, list.pop_back());
+    ASSERT_EQ(-1, list.pop_front());
+}
+
+TEST_F(DoublyLinkedListTest, Erase) {
+    ASSERT_THROW(list.erase(list.end()), std::out_of_range);
+    for (auto i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    for (auto it = list.begin(); it != list.end();) {
+        it = (*it % 2 == 0) ? list.erase(it) : std::next(it);
+    }
+    ASSERT_EQ((std::vector<int>{1, 3, 5, 7, 9}), contents(list));
+    list.erase(list.begin());
+    list.erase(std::prev(list.end()));
+    ASSERT_EQ((std::vector<int>{3, 5, 7}), contents(list));
+    ASSERT_EQ(7, list.pop_back());
+    ASSERT_EQ(3, list.pop_front());
+    list.erase(list.begin());
+    ASSERT_TRUE(list.empty());
+    ASSERT_TRUE(list.begin() == list.end());
+}
+
+TEST_F(DoublyLinkedListTest, SpliceWholeList) {
+    structures::DoublyLinkedList<int> other{};
+    for (auto i = 0; i < 3; ++i) {
+        list.push_back(i);
+        other.push_back(10 + i);
+    }
+    list.splice(std::next(list.begin()), other);
+    ASSERT_TRUE(other.empty());
+    ASSERT_EQ(6u, list.size());
+    ASSERT_EQ((std::vector<int>{0, 10, 11, 12, 1, 2}), contents(list));
+    other.push_back(20);
+    list.splice(list.end(), other);
+    ASSERT_EQ(20, list.pop_back());
+    ASSERT_EQ(2, list.pop_back());
+}
+
+TEST_F(DoublyLinkedListTest, SpliceRange) {
+    structures::DoublyLinkedList<int> other{};
+    for (auto i = 0; i < 5; ++i) {
+        list.push_back(i);
+        other.push_back(10 + i);
+    }
+    list.splice(list.begin(), other, std::next(other.begin()),
+                std::prev(other.end()));
+    ASSERT_EQ((std::vector<int>{11, 12, 13, 0, 1, 2, 3, 4}), contents(list));
+    ASSERT_EQ((std::vector<int>{10, 14}), contents(other));
+    ASSERT_EQ(8u, list.size());
+    ASSERT_EQ(2u, other.size());
+
+    /// Dentro da mesma lista: move o inicio para o fim
+    list.splice(list.end(), list, list.begin(), std::next(list.begin(), 3));
+    ASSERT_EQ((std::vector<int>{0, 1, 2, 3, 4, 11, 12, 13}), contents(list));
+    ASSERT_EQ(8u, list.size());
+    list.splice(list.begin(), list, list.begin(), list.end());
+    ASSERT_EQ(8u, list.size());
+
+    list.splice(list.end(), other, other.begin(), other.end());
+    ASSERT_TRUE(other.empty());
+    ASSERT_EQ(14, list.pop_back());
+    ASSERT_EQ(10, list.pop_back());
+    ASSERT_EQ(0, list.pop_front());
+}
+
+TEST_F(DoublyLinkedListTest, SpliceAcrossPools) {
+    structures::DoublyLinkedList<std::string, structures::PoolAllocator> a{};
+    structures::DoublyLinkedList<std::string, structures::PoolAllocator> b{};
+    a.push_back("a");
+    b.push_back("b");
+    b.push_back("c");
+    a.splice(a.end(), b);
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(3u, a.size());
+    ASSERT_EQ("c", a.pop_back());
+    ASSERT_EQ("b", a.pop_back());
+    ASSERT_EQ("a", a.pop_back());
+}
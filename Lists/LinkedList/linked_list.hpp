@@ -3,17 +3,33 @@
 #define STRUCTURES_LINKED_LIST_H
 
 #include <cstdint>
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
+
+#include "node_allocator.hpp"
 
 namespace structures {
 
-template<typename T>
+template<typename T, template<typename> class Allocator = NewAllocator>
 /// Classe Lista Encadeada
 class LinkedList {
+    class Node;
+
+    template<bool Const>
+    class Iterator;
+
  public:
+    /// Iteradores de avanco (forward iterators)
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
     /// Construtor / Destrutor
     LinkedList();
 
+    /// Construtor com um alocador (ex.: copia do alocador de outra lista)
+    explicit LinkedList(const Allocator<Node>& allocator);
+
     ~LinkedList();
 
     /// limpar lista
@@ -34,6 +50,10 @@ class LinkedList {
     /// acessar um elemento na posição index
     T& at(std::size_t index);
 
+    /// acessar o último elemento, em O(1)
+    T& back();
+    const T& back() const;
+
     /// retirar da posição
     T pop(std::size_t index);
 
@@ -58,6 +78,32 @@ class LinkedList {
     /// tamanho da lista
     std::size_t size() const;
 
+    /// alocador de nodos da lista
+    Allocator<Node> allocator() const;
+
+    /// concatenar outra lista ao fim, em O(1); other fica vazia
+    void append(LinkedList&& other);
+
+    /// mover todos os elementos de other para apos position, em O(1);
+    /// other fica vazia
+    void splice_after(const_iterator position, LinkedList& other);
+
+    /// iterador para o primeiro elemento
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+
+    /// iterador para depois do ultimo elemento
+    iterator end();
+    const_iterator end() const;
+    const_iterator cend() const;
+
+    /// inserir apos a posicao do iterador, em O(1)
+    iterator insert_after(const_iterator position, const T& data);
+
+    /// remover o elemento apos a posicao do iterador, em O(1)
+    iterator erase_after(const_iterator position);
+
  private:
     class Node {  /// Elemento
      public:
@@ -95,75 +141,147 @@ class LinkedList {
         Node* next_{nullptr};
     };
 
-    Node* end() {  // último nodo da lista
-        auto it = head;
-        for (auto i = 1u; i < size(); ++i) {
-            it = it->next();
+    template<bool Const>
+    class Iterator {  /// Iterador sobre os nodos
+     public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<Const, const T*, T*>::type pointer;
+        typedef typename std::conditional<Const, const T&, T&>::type reference;
+
+        Iterator() = default;
+
+        explicit Iterator(Node* node):
+            node_{node}
+        {}
+
+        Iterator(const Iterator<false>& other):  // iterator -> const_iterator
+            node_{other.node_}
+        {}
+
+        /// O construtor acima e' o de copia quando Const e' falso
+        Iterator& operator=(const Iterator&) = default;
+
+        reference operator*() const {
+            return node_->data();
         }
-        return it;
-    }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            node_ = node_->next();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old{*this};
+            node_ = node_->next();
+            return old;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            return a.node_ == b.node_;
+        }
+
+        friend bool operator!=(const Iterator& a, const Iterator& b) {
+            return a.node_ != b.node_;
+        }
+
+     private:
+        friend class LinkedList;
+        friend class Iterator<true>;
+
+        Node* node_{nullptr};
+    };
+
+    /// Transfere os nodos de other para apos prev (nullptr: no inicio)
+    void link_after(Node* prev, LinkedList& other);
 
     Node* head{nullptr};
+    Node* tail{nullptr};  // último nodo da lista
     std::size_t size_{0u};
+    Allocator<Node> allocator_;  // alocador de nodos
 };
 
 }  // namespace structures
 
 #endif
 
-template <typename T>
-structures::LinkedList<T>::LinkedList() {
+template <typename T, template<typename> class Allocator>
+structures::LinkedList<T, Allocator>::LinkedList() {
 	// Empty constructor
 }
 
-template <typename T>
-structures::LinkedList<T>::~LinkedList() {
+template <typename T, template<typename> class Allocator>
+structures::LinkedList<T, Allocator>::LinkedList(
+    const Allocator<Node>& allocator):
+    allocator_{allocator}
+{}
+
+template <typename T, template<typename> class Allocator>
+structures::LinkedList<T, Allocator>::~LinkedList() {
     clear();
 }
 
-template <typename T>
-void structures::LinkedList<T>::clear() {
+template <typename T, template<typename> class Allocator>
+void structures::LinkedList<T, Allocator>::clear() {
     Node *actual = head;
     for (unsigned int i = 0; i < size_; i++) {
         Node *aux = actual->next();
-        delete actual;
+        allocator_.destroy(actual);
         actual = aux;
     }
 
     head = nullptr;
+    tail = nullptr;
     size_ = 0;
 }
 
-template <typename T>
-void structures::LinkedList<T>::push_back(const T& data) {
-    insert(data, size_);
+template <typename T, template<typename> class Allocator>
+void structures::LinkedList<T, Allocator>::push_back(const T& data) {
+    if (empty()) {
+        push_front(data);
+        return;
+    }
+
+    tail->next(allocator_.create(data));
+    tail = tail->next();
+    size_++;
 }
 
-template <typename T>
-void structures::LinkedList<T>::push_front(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::LinkedList<T, Allocator>::push_front(const T& data) {
     insert(data, 0);
 }
 
-template <typename T>
-void structures::LinkedList<T>::insert(const T& data, std::size_t index) {
+template <typename T, template<typename> class Allocator>
+void structures::LinkedList<T, Allocator>::insert(const T& data, std::size_t index) {
     if ((index > size_) || (index < 0))
         throw std::out_of_range("Invalid index");
 
     if (empty() || (index == 0)) {
-        head = new Node(data, head);
+        head = allocator_.create(data, head);
+        if (tail == nullptr)
+            tail = head;
+    } else if (index == size_) {
+        push_back(data);
+        return;
     } else {
         Node *actual = head;
         for (unsigned int i = 0; i < index - 1; i++)
             actual = actual->next();
 
-        actual->next(new Node(data, actual->next()));  /// Insere o elemento em index
+        actual->next(allocator_.create(data, actual->next()));  /// Insere o elemento em index
     }
 
     size_++;
 }
 
-template <typename T>
-void structures::LinkedList<T>::insert_sorted(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::LinkedList<T, Allocator>::insert_sorted(const T& data) {
     unsigned int i = 0;
     if (!empty()) {
         Node *actual = head;
@@ -175,8 +293,8 @@ void structures::LinkedList<T>::insert_sorted(const T& data) {
     insert(data, i);
 }
 
-template <typename T>
-T& structures::LinkedList<T>::at(std::size_t index) {
+template <typename T, template<typename> class Allocator>
+T& structures::LinkedList<T, Allocator>::at(std::size_t index) {
     if ((index < 0) || (index >= size_))
         throw std::out_of_range("Invalid index");
 
@@ -187,8 +305,24 @@ T& structures::LinkedList<T>::at(std::size_t index) {
     return actual->data();
 }
 
-template <typename T>
-T structures::LinkedList<T>::pop(std::size_t index) {
+template <typename T, template<typename> class Allocator>
+T& structures::LinkedList<T, Allocator>::back() {
+    if (empty())
+        throw std::out_of_range("Empty list");
+
+    return tail->data();
+}
+
+template <typename T, template<typename> class Allocator>
+const T& structures::LinkedList<T, Allocator>::back() const {
+    if (empty())
+        throw std::out_of_range("Empty list");
+
+    return tail->data();
+}
+
+template <typename T, template<typename> class Allocator>
+T structures::LinkedList<T, Allocator>::pop(std::size_t index) {
     if (empty())
         throw std::out_of_range("Empty list");
     if ((index >= size_) || (index < 0))
@@ -207,35 +341,38 @@ T structures::LinkedList<T>::pop(std::size_t index) {
         actual->next(aux->next());  /// Seta como próximo, o elemento após index
     }
 
+    if (aux == tail)
+        tail = (index == 0) ? nullptr : actual;
+
     T data = aux->data();
-    delete aux;
+    allocator_.destroy(aux);
     size_--;
     return data;
 }
 
-template <typename T>
-T structures::LinkedList<T>::pop_back() {
+template <typename T, template<typename> class Allocator>
+T structures::LinkedList<T, Allocator>::pop_back() {
     return pop(size_ - 1);
 }
 
-template <typename T>
-T structures::LinkedList<T>::pop_front() {
+template <typename T, template<typename> class Allocator>
+T structures::LinkedList<T, Allocator>::pop_front() {
     return pop(0);
 }
 
-template <typename T>
-void structures::LinkedList<T>::remove(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::LinkedList<T, Allocator>::remove(const T& data) {
     if (contains(data))
         pop(find(data));
 }
 
-template <typename T>
-bool structures::LinkedList<T>::empty() const {
+template <typename T, template<typename> class Allocator>
+bool structures::LinkedList<T, Allocator>::empty() const {
     return size_ == 0;
 }
 
-template <typename T>
-bool structures::LinkedList<T>::contains(const T& data) const {
+template <typename T, template<typename> class Allocator>
+bool structures::LinkedList<T, Allocator>::contains(const T& data) const {
     Node *actual = head;
     for (unsigned int i = 0; i < size_; i++) {
         if (actual->data() == data)
@@ -246,8 +383,8 @@ bool structures::LinkedList<T>::contains(const T& data) const {
     return false;
 }
 
-template <typename T>
-std::size_t structures::LinkedList<T>::find(const T& data) const {
+template <typename T, template<typename> class Allocator>
+std::size_t structures::LinkedList<T, Allocator>::find(const T& data) const {
     Node *actual = head;
     unsigned int i = 0;
     while ((i < size_) && (actual->data() != data)) {
@@ -258,7 +395,126 @@ std::size_t structures::LinkedList<T>::find(const T& data) const {
     return i;
 }
 
-template <typename T>
-std::size_t structures::LinkedList<T>::size() const {
+template <typename T, template<typename> class Allocator>
+std::size_t structures::LinkedList<T, Allocator>::size() const {
     return size_;
 }
+
+template <typename T, template<typename> class Allocator>
+Allocator<typename structures::LinkedList<T, Allocator>::Node>
+structures::LinkedList<T, Allocator>::allocator() const {
+    return allocator_;
+}
+
+template <typename T, template<typename> class Allocator>
+void structures::LinkedList<T, Allocator>::append(LinkedList&& other) {
+    link_after(tail, other);
+}
+
+template <typename T, template<typename> class Allocator>
+void structures::LinkedList<T, Allocator>::splice_after(
+    const_iterator position, LinkedList& other) {
+    if (position.node_ == nullptr)
+        throw std::out_of_range("Invalid iterator");
+
+    link_after(position.node_, other);
+}
+
+template <typename T, template<typename> class Allocator>
+void structures::LinkedList<T, Allocator>::link_after(Node* prev,
+                                                      LinkedList& other) {
+    if ((&other == this) || other.empty())
+        return;
+
+    if (allocator_ != other.allocator_) {
+        /// Nodos de outro pool nao podem ser liberados por este alocador:
+        /// copia os dados, em O(n)
+        LinkedList copy{allocator_};
+        for (const auto& data : other)
+            copy.push_back(data);
+        other.clear();
+        link_after(prev, copy);
+        return;
+    }
+
+    Node* after = (prev == nullptr) ? head : prev->next();
+    if (prev == nullptr)
+        head = other.head;
+    else
+        prev->next(other.head);
+    other.tail->next(after);
+    if (after == nullptr)
+        tail = other.tail;
+
+    size_ += other.size_;
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size_ = 0;
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::LinkedList<T, Allocator>::iterator
+structures::LinkedList<T, Allocator>::begin() {
+    return iterator{head};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::LinkedList<T, Allocator>::const_iterator
+structures::LinkedList<T, Allocator>::begin() const {
+    return const_iterator{head};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::LinkedList<T, Allocator>::const_iterator
+structures::LinkedList<T, Allocator>::cbegin() const {
+    return const_iterator{head};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::LinkedList<T, Allocator>::iterator
+structures::LinkedList<T, Allocator>::end() {
+    return iterator{};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::LinkedList<T, Allocator>::const_iterator
+structures::LinkedList<T, Allocator>::end() const {
+    return const_iterator{};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::LinkedList<T, Allocator>::const_iterator
+structures::LinkedList<T, Allocator>::cend() const {
+    return const_iterator{};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::LinkedList<T, Allocator>::iterator
+structures::LinkedList<T, Allocator>::insert_after(const_iterator position,
+                                                   const T& data) {
+    Node *actual = position.node_;
+    if (actual == nullptr)
+        throw std::out_of_range("Invalid iterator");
+
+    actual->next(allocator_.create(data, actual->next()));
+    if (actual == tail)
+        tail = actual->next();
+    size_++;
+    return iterator{actual->next()};
+}
+
+template <typename T, template<typename> class Allocator>
+typename structures::LinkedList<T, Allocator>::iterator
+structures::LinkedList<T, Allocator>::erase_after(const_iterator position) {
+    Node *actual = position.node_;
+    if ((actual == nullptr) || (actual->next() == nullptr))
+        throw std::out_of_range("Invalid iterator");
+
+    Node *aux = actual->next();
+    actual->next(aux->next());
+    if (aux == tail)
+        tail = actual;
+    allocator_.destroy(aux);
+    size_--;
+    return iterator{actual->next()};
+}
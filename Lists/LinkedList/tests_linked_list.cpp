@@ -1,3 +1,6 @@
+#include <iterator>
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "linked_list.hpp"
 
@@ -208,3 +211,178 @@ TEST_F(LinkedListTest, RemoveElement) {
     ASSERT_EQ(9u, list.size());
     ASSERT_FALSE(list.contains(4));
 }
+
+TEST_F(LinkedListTest, PoolAllocator) {
+    structures::LinkedList<int, structures::PoolAllocator> pooled{};
+    for (auto round = 0; round < 10; ++round) {
+        for (auto i = 0; i < 100; ++i) {
+            pooled.push_front(i);
+        }
+        ASSERT_EQ(100u, pooled.size());
+        for (auto i = 0; i < 100; ++i) {
+            ASSERT_EQ(i, pooled.pop_back());
+        }
+        ASSERT_TRUE(pooled.empty());
+    }
+    pooled.push_front(1);
+}
+
+TEST_F(LinkedListTest, PoolReusesFreedNodes) {
+    structures::PoolAllocator<int> pool;
+    int* nodes[DEFAULT_SLAB_SIZE];
+    for (auto round = 0; round < 10; ++round) {
+        for (auto& node : nodes) {
+            node = pool.create(round);
+        }
+        for (auto& node : nodes) {
+            pool.destroy(node);
+        }
+    }
+    ASSERT_EQ(1u, pool.slabs());
+}
+
+TEST_F(LinkedListTest, RangeFor) {
+    for (auto i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    auto expected = 0;
+    for (auto& data : list) {
+        ASSERT_EQ(expected++, data);
+        data *= 2;
+    }
+    ASSERT_EQ(10, expected);
+    const auto& const_list = list;
+    expected = 0;
+    for (auto it = const_list.begin(); it != const_list.end(); ++it) {
+        ASSERT_EQ(expected, *it);
+        expected += 2;
+    }
+    ASSERT_EQ(90, std::accumulate(list.cbegin(), list.cend(), 0));
+}
+
+TEST_F(LinkedListTest, EmptyIteration) {
+    ASSERT_TRUE(list.begin() == list.end());
+    ASSERT_THROW(list.insert_after(list.end(), 0), std::out_of_range);
+    ASSERT_THROW(list.erase_after(list.end()), std::out_of_range);
+}
+
+TEST_F(LinkedListTest, InsertAfter) {
+    list.push_back(0);
+    auto it = list.begin();
+    for (auto i = 1; i < 10; ++i) {
+        it = list.insert_after(it, i);
+    }
+    ASSERT_EQ(10u, list.size());
+    for (auto i = 0; i < 10; ++i) {
+        ASSERT_EQ(i, list.at(i));
+    }
+    list.push_back(10);
+    ASSERT_EQ(11u, list.size());
+    ASSERT_EQ(10, list.at(10));
+}
+
+TEST_F(LinkedListTest, EraseAfter) {
+    for (auto i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    auto it = list.begin();
+    while (it != list.end()) {  // remove os impares
+        auto next = it;
+        if (++next == list.end())
+            break;
+        it = list.erase_after(it);
+    }
+    ASSERT_EQ(5u, list.size());
+    for (auto i = 0; i < 5; ++i) {
+        ASSERT_EQ(2 * i, list.at(i));
+    }
+    auto last = list.begin();
+    std::advance(last, 4);
+    ASSERT_THROW(list.erase_after(last), std::out_of_range);
+    list.push_back(10);
+    ASSERT_EQ(10, list.pop_back());
+}
+
+TEST_F(LinkedListTest, Back) {
+    ASSERT_THROW(list.back(), std::out_of_range);
+    for (auto i = 0; i < 10; ++i) {
+        list.push_back(i);
+        ASSERT_EQ(i, list.back());
+    }
+    list.pop_back();
+    list.push_back(20);
+    ASSERT_EQ(20, list.back());
+    list.insert(30, list.size());
+    ASSERT_EQ(30, list.back());
+    list.erase_after(std::next(list.begin(), 9));
+    ASSERT_EQ(20, list.back());
+    list.insert_after(std::next(list.begin(), 9), 40);
+    ASSERT_EQ(40, list.back());
+    while (list.size() > 1) {
+        list.pop_front();
+    }
+    ASSERT_EQ(40, list.back());
+    list.pop_front();
+    ASSERT_THROW(list.back(), std::out_of_range);
+    list.push_front(50);
+    ASSERT_EQ(50, list.back());
+}
+
+TEST_F(LinkedListTest, Append) {
+    structures::LinkedList<int> other{};
+    list.append(std::move(other));
+    ASSERT_TRUE(list.empty());
+    for (auto i = 0; i < 5; ++i) {
+        other.push_back(i);
+    }
+    list.append(std::move(other));
+    ASSERT_TRUE(other.empty());
+    for (auto i = 5; i < 10; ++i) {
+        other.push_back(i);
+    }
+    list.append(std::move(other));
+    ASSERT_EQ(10u, list.size());
+    ASSERT_EQ(9, list.back());
+    list.push_back(10);
+    for (auto i = 0; i <= 10; ++i) {
+        ASSERT_EQ(i, list.at(i));
+    }
+    other.push_back(0);
+    ASSERT_EQ(0, other.back());
+}
+
+TEST_F(LinkedListTest, SpliceAfter) {
+    structures::LinkedList<int> other{};
+    list.push_back(0);
+    list.push_back(3);
+    other.push_back(1);
+    other.push_back(2);
+    list.splice_after(list.begin(), other);
+    ASSERT_TRUE(other.empty());
+    ASSERT_EQ(4u, list.size());
+    for (auto i = 0; i < 4; ++i) {
+        ASSERT_EQ(i, list.at(i));
+    }
+    other.push_back(4);
+    list.splice_after(std::next(list.begin(), 3), other);
+    ASSERT_EQ(4, list.back());
+    ASSERT_THROW(list.splice_after(list.end(), other), std::out_of_range);
+}
+
+TEST_F(LinkedListTest, AppendAcrossPools) {
+    structures::LinkedList<int, structures::PoolAllocator> pooled{};
+    structures::LinkedList<int, structures::PoolAllocator> shared{
+        pooled.allocator()};
+    structures::LinkedList<int, structures::PoolAllocator> foreign{};
+    for (auto i = 0; i < 10; ++i) {
+        shared.push_back(i);
+        foreign.push_back(10 + i);
+    }
+    pooled.append(std::move(shared));
+    pooled.append(std::move(foreign));
+    ASSERT_EQ(20u, pooled.size());
+    for (auto i = 0; i < 20; ++i) {
+        ASSERT_EQ(i, pooled.pop_front());
+    }
+    ASSERT_EQ(1u, pooled.allocator().slabs());
+}
@@ -10,7 +10,7 @@
 namespace structures {
 
 template<typename T>
-/// Classe que implementa uma fila baseada em vetor
+/// Classe que implementa uma fila baseada em vetor circular
 class ArrayQueue {
  public:
     ArrayQueue();
@@ -26,6 +26,9 @@ class ArrayQueue {
     /// Remove um elemento da fila
     T dequeue();
 
+    /// Retorna o primeiro elemento da fila
+    T& front();
+
     /// Retorna o ultimo elemento da fila
     T& back();
 
@@ -45,12 +48,15 @@ class ArrayQueue {
     bool full();
 
  private:
+    /// Menor potencia de 2 maior ou igual a max (tamanho do vetor)
+    static std::size_t capacity(std::size_t max);
+
     T* contents;
     std::size_t size_;
     std::size_t max_size_;
-
-    /// Faz a fila "andar" quando algum elemento sai
-    void moveElements();
+    std::size_t head_{0u};  // indice do primeiro elemento
+    std::size_t tail_{0u};  // indice onde entra o proximo elemento
+    std::size_t mask_;  // tamanho do vetor - 1: indice & mask_ da' a volta
 };
 
 }  // namespace structures
@@ -59,16 +65,18 @@ class ArrayQueue {
 
 template<typename T>
 structures::ArrayQueue<T>::ArrayQueue() {
-    contents = new T[DEFAULT_SIZE];
+    contents = new T[capacity(DEFAULT_SIZE)];
     size_ = 0;
     max_size_ = DEFAULT_SIZE;
+    mask_ = capacity(DEFAULT_SIZE) - 1;
 }
 
 template<typename T>
 structures::ArrayQueue<T>::ArrayQueue(std::size_t max) {
-    contents = new T[max];
+    contents = new T[capacity(max)];
     size_ = 0;
     max_size_ = max;
+    mask_ = capacity(max) - 1;
 }
 
 template<typename T>
@@ -81,7 +89,9 @@ void structures::ArrayQueue<T>::enqueue(const T& data) {
     if (full())
         throw std::out_of_range("Full queue!");
 
-    contents[size_++] = data;
+    contents[tail_] = data;
+    tail_ = (tail_ + 1) & mask_;
+    size_++;
 }
 
 template<typename T>
@@ -89,23 +99,33 @@ T structures::ArrayQueue<T>::dequeue() {
     if (empty())
         throw std::out_of_range("Empty queue!");
 
-    T aux = contents[0];
+    T aux = contents[head_];
+    head_ = (head_ + 1) & mask_;
     size_--;
-    moveElements();
     return aux;
 }
 
+template<typename T>
+T& structures::ArrayQueue<T>::front() {
+    if (empty())
+        throw std::out_of_range("Empty queue!");
+
+    return contents[head_];
+}
+
 template<typename T>
 T& structures::ArrayQueue<T>::back() {
     if (empty())
         throw std::out_of_range("Empty queue!");
 
-    return contents[size_ - 1];
+    return contents[(tail_ - 1) & mask_];
 }
 
 template<typename T>
 void structures::ArrayQueue<T>::clear() {
     size_ = 0;
+    head_ = 0;
+    tail_ = 0;
 }
 
 template<typename T>
@@ -129,8 +149,10 @@ bool structures::ArrayQueue<T>::full() {
 }
 
 template<typename T>
-void structures::ArrayQueue<T>::moveElements() {
-    for (unsigned int i = 0; i < size_; i++) {
-        contents[i] = contents[i+1];
-    }
+std::size_t structures::ArrayQueue<T>::capacity(std::size_t max) {
+    std::size_t capacity = 1;
+    while (capacity < max)
+        capacity <<= 1;
+
+    return capacity;
 }
@@ -70,3 +70,33 @@ TEST_F(ArrayQueueTest, FullQueue) {
     ASSERT_TRUE(queue.full());
     ASSERT_THROW(queue.enqueue(0), std::out_of_range);
 }
+
+TEST_F(ArrayQueueTest, Front) {
+    ASSERT_THROW(queue.front(), std::out_of_range);
+    queue.enqueue(1);
+    queue.enqueue(2);
+    ASSERT_EQ(1, queue.front());
+    ASSERT_EQ(2, queue.back());
+    queue.dequeue();
+    ASSERT_EQ(2, queue.front());
+}
+
+TEST_F(ArrayQueueTest, WrapAround) {
+    for (auto round = 0; round < 5; ++round) {
+        for (auto i = 0; i < 7; ++i) {
+            queue.enqueue(round * 10 + i);
+        }
+        ASSERT_EQ(round * 10 + 6, queue.back());
+        for (auto i = 0; i < 7; ++i) {
+            ASSERT_EQ(round * 10 + i, queue.front());
+            ASSERT_EQ(round * 10 + i, queue.dequeue());
+        }
+        ASSERT_TRUE(queue.empty());
+    }
+    for (auto i = 0; i < 10; ++i) {
+        queue.enqueue(i);
+    }
+    ASSERT_TRUE(queue.full());
+    ASSERT_EQ(0, queue.front());
+    ASSERT_EQ(9, queue.back());
+}
@@ -5,9 +5,11 @@
 #include <cstdint>
 #include <stdexcept>
 
+#include "node_allocator.hpp"
+
 namespace structures {
 
-template<typename T>
+template<typename T, template<typename> class Allocator = NewAllocator>
 /// Classe Fila Encadeada
 class LinkedQueue {
  public:
@@ -69,28 +71,29 @@ class LinkedQueue {
     Node* head{nullptr};  // nodo-cabeça
     Node* tail{nullptr};  // nodo-fim
     std::size_t size_{0u};  // tamanho
+    Allocator<Node> allocator_;  // alocador de nodos
 };
 
 }  /// namespace structures
 
 #endif
 
-template <typename T>
-structures::LinkedQueue<T>::LinkedQueue() {
+template <typename T, template<typename> class Allocator>
+structures::LinkedQueue<T, Allocator>::LinkedQueue() {
     /// Empty constructor
 }
 
-template <typename T>
-structures::LinkedQueue<T>::~LinkedQueue() {
+template <typename T, template<typename> class Allocator>
+structures::LinkedQueue<T, Allocator>::~LinkedQueue() {
     clear();
 }
 
-template <typename T>
-void structures::LinkedQueue<T>::clear() {
+template <typename T, template<typename> class Allocator>
+void structures::LinkedQueue<T, Allocator>::clear() {
     Node *aux = head;
     for (unsigned int i = 0; i < size_; i++) {
         Node *next = aux->next();
-        delete aux;
+        allocator_.destroy(aux);
         aux = next;
     }
     size_ = 0;
@@ -98,9 +101,9 @@ void structures::LinkedQueue<T>::clear() {
 	tail = nullptr;
 }
 
-template <typename T>
-void structures::LinkedQueue<T>::enqueue(const T& data) {
-    Node *node = new Node(data);
+template <typename T, template<typename> class Allocator>
+void structures::LinkedQueue<T, Allocator>::enqueue(const T& data) {
+    Node *node = allocator_.create(data);
     if (empty()) {
         head = node;
     } else {
@@ -110,39 +113,41 @@ void structures::LinkedQueue<T>::enqueue(const T& data) {
     size_++;
 }
 
-template <typename T>
-T structures::LinkedQueue<T>::dequeue() {
+template <typename T, template<typename> class Allocator>
+T structures::LinkedQueue<T, Allocator>::dequeue() {
     if (empty())
         throw std::out_of_range("Empty queue");
 
-    T data = head->data();
-    head = head->next();
+    Node *aux = head;
+    T data = aux->data();
+    head = aux->next();
+    allocator_.destroy(aux);
     size_--;
     return data;
 }
 
-template <typename T>
-T& structures::LinkedQueue<T>::front() const {
+template <typename T, template<typename> class Allocator>
+T& structures::LinkedQueue<T, Allocator>::front() const {
     if (empty())
         throw std::out_of_range("Empty queue");
 
     return head->data();
 }
 
-template <typename T>
-T& structures::LinkedQueue<T>::back() const {
+template <typename T, template<typename> class Allocator>
+T& structures::LinkedQueue<T, Allocator>::back() const {
     if (empty())
         throw std::out_of_range("Empty queue");
 
     return tail->data();
 }
 
-template <typename T>
-bool structures::LinkedQueue<T>::empty() const {
+template <typename T, template<typename> class Allocator>
+bool structures::LinkedQueue<T, Allocator>::empty() const {
     return size_ == 0;
 }
 
-template <typename T>
-std::size_t structures::LinkedQueue<T>::size() const {
+template <typename T, template<typename> class Allocator>
+std::size_t structures::LinkedQueue<T, Allocator>::size() const {
     return size_;
 }
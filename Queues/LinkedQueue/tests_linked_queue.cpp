@@ -69,3 +69,18 @@ TEST_F(LinkedQueueTest, NotEmptyQueue) {
     ASSERT_THROW(queue.back(), std::out_of_range);
     ASSERT_THROW(queue.dequeue(), std::out_of_range);
 }
+
+TEST_F(LinkedQueueTest, PoolAllocator) {
+    structures::LinkedQueue<int, structures::PoolAllocator> pooled{};
+    for (auto round = 0; round < 10; ++round) {
+        for (auto i = 0; i < 100; ++i) {
+            pooled.enqueue(i);
+        }
+        ASSERT_EQ(100u, pooled.size());
+        for (auto i = 0; i < 100; ++i) {
+            ASSERT_EQ(i, pooled.dequeue());
+        }
+        ASSERT_TRUE(pooled.empty());
+    }
+    pooled.enqueue(1);
+}
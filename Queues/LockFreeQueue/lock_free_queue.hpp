@@ -0,0 +1,166 @@
+/// Copyright [2018] <João Fellipe Uller>
+#ifndef STRUCTURES_LOCK_FREE_QUEUE_H
+#define STRUCTURES_LOCK_FREE_QUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "hazard_pointer.hpp"
+
+#define CACHE_LINE_SIZE 64u
+
+namespace structures {
+
+template<typename T>
+/// Fila encadeada concorrente e sem locks (algoritmo de Michael-Scott)
+///
+/// head aponta para um nodo-sentinela: o primeiro dado esta em head->next.
+/// Nodos retirados sao liberados por hazard pointers.
+class LockFreeQueue {
+ public:
+    LockFreeQueue();
+
+    ~LockFreeQueue();
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    /// enfileirar
+    void enqueue(const T& data);
+    /// desenfileirar
+    T dequeue();
+    /// tenta desenfileirar para data; retorna false se a fila esta vazia
+    bool try_dequeue(T& data);
+    /// fila vazia
+    bool empty() const;
+    /// tamanho (aproximado se ha acesso concorrente)
+    std::size_t size() const;
+
+ private:
+    class Node {
+     public:
+        Node() {}
+
+        explicit Node(const T& data):
+            data_{data}
+        {}
+
+        T& data() {  // getter: info
+            return data_;
+        }
+
+        std::atomic<Node*>& next() {  // getter: próximo
+            return next_;
+        }
+
+     private:
+        T data_{};
+        std::atomic<Node*> next_{nullptr};
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<Node*> head{nullptr};  // sentinela
+    alignas(CACHE_LINE_SIZE) std::atomic<Node*> tail{nullptr};  // nodo-fim
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> size_{0u};  // tamanho
+};
+
+}  // namespace structures
+
+template <typename T>
+structures::LockFreeQueue<T>::LockFreeQueue() {
+    Node *sentinel = new Node();
+    head.store(sentinel);
+    tail.store(sentinel);
+}
+
+template <typename T>
+structures::LockFreeQueue<T>::~LockFreeQueue() {
+    Node *aux = head.load();
+    while (aux != nullptr) {
+        Node *next = aux->next().load();
+        delete aux;
+        aux = next;
+    }
+}
+
+template <typename T>
+void structures::LockFreeQueue<T>::enqueue(const T& data) {
+    Node *node = new Node(data);
+    while (true) {
+        Node *last = HazardPointers::protect(0, tail);
+        Node *next = last->next().load(std::memory_order_acquire);
+        if (last != tail.load(std::memory_order_acquire))
+            continue;
+
+        if (next != nullptr) {  // tail atrasado: ajuda a avanca-lo
+            tail.compare_exchange_weak(last, next);
+            continue;
+        }
+
+        Node *expected = nullptr;
+        if (last->next().compare_exchange_weak(expected, node)) {
+            tail.compare_exchange_strong(last, node);
+            break;
+        }
+    }
+
+    HazardPointers::clear(0);
+    size_.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+T structures::LockFreeQueue<T>::dequeue() {
+    T data;
+    if (!try_dequeue(data))
+        throw std::out_of_range("Empty queue");
+
+    return data;
+}
+
+template <typename T>
+bool structures::LockFreeQueue<T>::try_dequeue(T& data) {
+    while (true) {
+        Node *first = HazardPointers::protect(0, head);
+        Node *last = tail.load(std::memory_order_acquire);
+        Node *next = HazardPointers::protect(1, first->next());
+        if (first != head.load(std::memory_order_acquire))
+            continue;
+
+        if (next == nullptr) {
+            HazardPointers::clear(0);
+            HazardPointers::clear(1);
+            return false;
+        }
+
+        if (first == last) {  // tail atrasado: ajuda a avanca-lo
+            tail.compare_exchange_weak(last, next);
+            continue;
+        }
+
+        if (head.compare_exchange_strong(first, next)) {
+            /// next vira a nova sentinela; so' esta thread acessa seu dado
+            data = std::move(next->data());
+            HazardPointers::clear(0);
+            HazardPointers::clear(1);
+            HazardPointers::retire(first);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+template <typename T>
+bool structures::LockFreeQueue<T>::empty() const {
+    Node *first = HazardPointers::protect(0, head);
+    bool empty = first->next().load(std::memory_order_acquire) == nullptr;
+    HazardPointers::clear(0);
+    return empty;
+}
+
+template <typename T>
+std::size_t structures::LockFreeQueue<T>::size() const {
+    return size_.load(std::memory_order_relaxed);
+}
+
+#endif
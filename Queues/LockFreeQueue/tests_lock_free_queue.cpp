@@ -0,0 +1,130 @@
+/// Copyright [2018] <João Fellipe Uller>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lock_free_queue.hpp"
+
+int main(int argc, char* argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class LockFreeQueueTest: public ::testing::Test {
+protected:
+    structures::LockFreeQueue<int> queue;
+};
+
+
+TEST_F(LockFreeQueueTest, Enqueue) {
+    ASSERT_TRUE(queue.empty());
+    for (auto i = 0; i < 10; ++i) {
+        queue.enqueue(i);
+    }
+    ASSERT_EQ(10u, queue.size());
+    ASSERT_FALSE(queue.empty());
+}
+
+TEST_F(LockFreeQueueTest, Dequeue) {
+    for (auto i = 0; i < 10; ++i) {
+        queue.enqueue(i);
+    }
+    for (auto i = 0; i < 10; ++i) {
+        ASSERT_EQ(i, queue.dequeue());
+    }
+    ASSERT_TRUE(queue.empty());
+    ASSERT_EQ(0u, queue.size());
+}
+
+TEST_F(LockFreeQueueTest, EmptyQueue) {
+    int data;
+    ASSERT_FALSE(queue.try_dequeue(data));
+    ASSERT_THROW(queue.dequeue(), std::out_of_range);
+}
+
+TEST_F(LockFreeQueueTest, NonTrivialData) {
+    structures::LockFreeQueue<std::string> strings;
+    strings.enqueue("first");
+    strings.enqueue("second");
+    ASSERT_EQ("first", strings.dequeue());
+    ASSERT_EQ("second", strings.dequeue());
+    strings.enqueue("left behind");
+}
+
+TEST_F(LockFreeQueueTest, StressManyProducersManyConsumers) {
+    const auto producers = 4;
+    const auto consumers = 4;
+    const auto per_producer = 20000;
+
+    std::vector<std::atomic<int>> seen(producers * per_producer);
+    for (auto& count : seen) {
+        count.store(0);
+    }
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (auto p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            for (auto i = 0; i < per_producer; ++i) {
+                queue.enqueue(p * per_producer + i);
+            }
+        });
+    }
+    for (auto c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            int data;
+            while (consumed.load() < producers * per_producer) {
+                if (queue.try_dequeue(data)) {
+                    seen[data]++;
+                    consumed++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto& count : seen) {
+        ASSERT_EQ(1, count.load());
+    }
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST_F(LockFreeQueueTest, PerProducerOrder) {
+    const auto per_producer = 20000;
+    std::thread first([&]() {
+        for (auto i = 0; i < per_producer; ++i) {
+            queue.enqueue(i);
+        }
+    });
+    std::thread second([&]() {
+        for (auto i = 0; i < per_producer; ++i) {
+            queue.enqueue(per_producer + i);
+        }
+    });
+
+    auto last_first = -1;
+    auto last_second = per_producer - 1;
+    auto received = 0;
+    int data;
+    while (received < 2 * per_producer) {
+        if (!queue.try_dequeue(data))
+            continue;
+        if (data < per_producer) {
+            ASSERT_GT(data, last_first);
+            last_first = data;
+        } else {
+            ASSERT_GT(data, last_second);
+            last_second = data;
+        }
+        ++received;
+    }
+    first.join();
+    second.join();
+}
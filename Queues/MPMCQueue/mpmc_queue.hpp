@@ -0,0 +1,220 @@
+/// Copyright [2018] <João Fellipe Uller>
+#ifndef STRUCTURES_MPMC_QUEUE_H
+#define STRUCTURES_MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>  // C++ Exceptions
+#include <thread>  // std::this_thread::yield
+#include <utility>
+
+#define DEFAULT_SIZE 10u
+#define CACHE_LINE_SIZE 64u
+
+namespace structures {
+
+template<typename T>
+/// Fila circular limitada para varios produtores e varios consumidores
+///
+/// Cada posicao do vetor guarda um numero de sequencia que diz de quem e' a
+/// vez: igual a posicao do produtor quando esta livre e igual a posicao + 1
+/// quando esta ocupada. Produtores e consumidores disputam apenas o proprio
+/// indice (com CAS), sem locks.
+class MPMCQueue {
+ public:
+    MPMCQueue();
+
+    /// Construtor parametrizado (o tamanho maximo e' arredondado para uma
+    /// potencia de 2, no minimo 2)
+    explicit MPMCQueue(std::size_t max);
+
+    ~MPMCQueue();
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    /// Adiciona um elemento na fila
+    void enqueue(const T& data);
+
+    /// Remove um elemento da fila
+    T dequeue();
+
+    /// Tenta adicionar um elemento; retorna false se a fila esta cheia
+    bool try_enqueue(const T& data);
+
+    /// Tenta remover um elemento para data; retorna false se a fila esta vazia
+    bool try_dequeue(T& data);
+
+    /// Adiciona um elemento, esperando ate haver espaco
+    void wait_enqueue(const T& data);
+
+    /// Remove um elemento, esperando ate a fila ter algum
+    T wait_dequeue();
+
+    /// Retorna o tamanho atual da fila (aproximado se ha acesso concorrente)
+    std::size_t size() const;
+
+    /// Retorna o tamanho maximo da fila
+    std::size_t max_size() const;
+
+    /// Retorna se a fila está vazia
+    bool empty() const;
+
+    /// Retorna se a fila está cheia
+    bool full() const;
+
+ private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    /// Menor potencia de 2 maior ou igual a max (no minimo 2)
+    static std::size_t capacity(std::size_t max);
+
+    Cell* cells;
+    std::size_t mask_;  // tamanho do vetor - 1: indice & mask_ da' a volta
+
+    /// Indices de produtores e consumidores em linhas de cache separadas
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_pos_{0u};
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeue_pos_{0u};
+};
+
+}  // namespace structures
+
+template<typename T>
+structures::MPMCQueue<T>::MPMCQueue():
+    MPMCQueue(DEFAULT_SIZE)
+{}
+
+template<typename T>
+structures::MPMCQueue<T>::MPMCQueue(std::size_t max) {
+    std::size_t size = capacity(max);
+    cells = new Cell[size];
+    for (std::size_t i = 0; i < size; i++)
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    mask_ = size - 1;
+}
+
+template<typename T>
+structures::MPMCQueue<T>::~MPMCQueue() {
+    delete[] cells;
+}
+
+template<typename T>
+void structures::MPMCQueue<T>::enqueue(const T& data) {
+    if (!try_enqueue(data))
+        throw std::out_of_range("Full queue!");
+}
+
+template<typename T>
+T structures::MPMCQueue<T>::dequeue() {
+    T data;
+    if (!try_dequeue(data))
+        throw std::out_of_range("Empty queue!");
+
+    return data;
+}
+
+template<typename T>
+bool structures::MPMCQueue<T>::try_enqueue(const T& data) {
+    Cell* cell;
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &cells[pos & mask_];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(sequence)
+                  - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {  // posicao livre: tenta reserva-la
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                   std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {  // posicao ainda ocupada: fila cheia
+            return false;
+        } else {  // outro produtor ja reservou a posicao
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->data = data;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+bool structures::MPMCQueue<T>::try_dequeue(T& data) {
+    Cell* cell;
+    std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &cells[pos & mask_];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(sequence)
+                  - static_cast<std::intptr_t>(pos + 1);
+        if (diff == 0) {  // posicao ocupada: tenta reserva-la
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                   std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {  // posicao ainda nao escrita: fila vazia
+            return false;
+        } else {  // outro consumidor ja reservou a posicao
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    data = std::move(cell->data);
+    /// Libera a posicao para o produtor da proxima volta
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+void structures::MPMCQueue<T>::wait_enqueue(const T& data) {
+    while (!try_enqueue(data))
+        std::this_thread::yield();
+}
+
+template<typename T>
+T structures::MPMCQueue<T>::wait_dequeue() {
+    T data;
+    while (!try_dequeue(data))
+        std::this_thread::yield();
+
+    return data;
+}
+
+template<typename T>
+std::size_t structures::MPMCQueue<T>::size() const {
+    std::size_t dequeued = dequeue_pos_.load(std::memory_order_acquire);
+    std::size_t enqueued = enqueue_pos_.load(std::memory_order_acquire);
+    if (enqueued <= dequeued)
+        return 0;
+
+    return (enqueued - dequeued > max_size()) ? max_size()
+                                              : enqueued - dequeued;
+}
+
+template<typename T>
+std::size_t structures::MPMCQueue<T>::max_size() const {
+    return mask_ + 1;
+}
+
+template<typename T>
+bool structures::MPMCQueue<T>::empty() const {
+    return size() == 0;
+}
+
+template<typename T>
+bool structures::MPMCQueue<T>::full() const {
+    return size() == max_size();
+}
+
+template<typename T>
+std::size_t structures::MPMCQueue<T>::capacity(std::size_t max) {
+    std::size_t capacity = 2;
+    while (capacity < max)
+        capacity <<= 1;
+
+    return capacity;
+}
+
+#endif
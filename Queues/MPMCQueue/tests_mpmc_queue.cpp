@@ -0,0 +1,102 @@
+/// Copyright [2018] <João Fellipe Uller>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mpmc_queue.hpp"
+
+int main(int argc, char* argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class MPMCQueueTest: public ::testing::Test {
+protected:
+    structures::MPMCQueue<int> queue{16u};
+};
+
+
+TEST_F(MPMCQueueTest, Enqueue) {
+    queue.enqueue(0);
+    ASSERT_EQ(1u, queue.size());
+    queue.enqueue(2);
+    ASSERT_EQ(2u, queue.size());
+    ASSERT_FALSE(queue.empty());
+}
+
+TEST_F(MPMCQueueTest, Dequeue) {
+    for (auto i = 0; i < 16; ++i) {
+        queue.enqueue(i);
+    }
+    for (auto i = 0; i < 16; ++i) {
+        ASSERT_EQ(i, queue.dequeue());
+    }
+    ASSERT_TRUE(queue.empty());
+    ASSERT_THROW(queue.dequeue(), std::out_of_range);
+}
+
+TEST_F(MPMCQueueTest, FullQueue) {
+    for (auto i = 0; i < (int)queue.max_size(); ++i) {
+        ASSERT_TRUE(queue.try_enqueue(i));
+    }
+    ASSERT_TRUE(queue.full());
+    ASSERT_FALSE(queue.try_enqueue(0));
+    ASSERT_THROW(queue.enqueue(0), std::out_of_range);
+}
+
+TEST_F(MPMCQueueTest, MaxSizeRoundsUp) {
+    ASSERT_EQ(16u, structures::MPMCQueue<int>{10u}.max_size());
+    ASSERT_EQ(2u, structures::MPMCQueue<int>{1u}.max_size());
+}
+
+TEST_F(MPMCQueueTest, WrapAround) {
+    int data;
+    for (auto round = 0; round < 10; ++round) {
+        for (auto i = 0; i < 11; ++i) {
+            ASSERT_TRUE(queue.try_enqueue(round * 100 + i));
+        }
+        for (auto i = 0; i < 11; ++i) {
+            ASSERT_TRUE(queue.try_dequeue(data));
+            ASSERT_EQ(round * 100 + i, data);
+        }
+        ASSERT_FALSE(queue.try_dequeue(data));
+    }
+}
+
+TEST_F(MPMCQueueTest, ManyProducersManyConsumers) {
+    const auto producers = 4;
+    const auto consumers = 4;
+    const auto per_producer = 50000;
+    structures::MPMCQueue<int> channel{64u};
+
+    std::vector<std::atomic<int>> seen(producers * per_producer);
+    for (auto& count : seen) {
+        count.store(0);
+    }
+
+    std::vector<std::thread> threads;
+    for (auto p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            for (auto i = 0; i < per_producer; ++i) {
+                channel.wait_enqueue(p * per_producer + i);
+            }
+        });
+    }
+    for (auto c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            for (auto i = 0; i < producers * per_producer / consumers; ++i) {
+                seen[channel.wait_dequeue()]++;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto& count : seen) {
+        ASSERT_EQ(1, count.load());
+    }
+    ASSERT_TRUE(channel.empty());
+}
@@ -0,0 +1,201 @@
+/// Copyright [2018] <João Fellipe Uller>
+#ifndef STRUCTURES_SPSC_QUEUE_H
+#define STRUCTURES_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>  // C++ Exceptions
+
+#define DEFAULT_SIZE 10u
+#define CACHE_LINE_SIZE 64u
+
+namespace structures {
+
+template<typename T>
+/// Fila circular sem locks para um unico produtor e um unico consumidor
+///
+/// Segue o modelo da ArrayQueue (vetor circular de tamanho potencia de 2),
+/// mas head/tail sao atomicos: enqueue/try_enqueue* so podem ser chamados
+/// pela thread produtora e dequeue/try_dequeue* pela thread consumidora.
+class SPSCQueue {
+ public:
+    SPSCQueue();
+
+    /// Construtor parametrizado
+    explicit SPSCQueue(std::size_t max);
+
+    ~SPSCQueue();
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    /// Adiciona um elemento na fila (produtor)
+    void enqueue(const T& data);
+
+    /// Remove um elemento da fila (consumidor)
+    T dequeue();
+
+    /// Tenta adicionar um elemento; retorna false se a fila esta cheia
+    bool try_enqueue(const T& data);
+
+    /// Tenta remover um elemento para data; retorna false se a fila esta vazia
+    bool try_dequeue(T& data);
+
+    /// Adiciona ate count elementos a partir de first; retorna quantos entraram
+    template<typename InputIt>
+    std::size_t try_enqueue_bulk(InputIt first, std::size_t count);
+
+    /// Remove ate count elementos para out; retorna quantos sairam
+    template<typename OutputIt>
+    std::size_t try_dequeue_bulk(OutputIt out, std::size_t count);
+
+    /// Retorna o tamanho atual da fila (aproximado se ha acesso concorrente)
+    std::size_t size() const;
+
+    /// Retorna o tamanho maximo da fila
+    std::size_t max_size() const;
+
+    /// Retorna se a fila está vazia
+    bool empty() const;
+
+    /// Retorna se a fila está cheia
+    bool full() const;
+
+ private:
+    /// Menor potencia de 2 maior ou igual a max (tamanho do vetor)
+    static std::size_t capacity(std::size_t max);
+
+    /// Dados somente leitura, compartilhados pelas duas threads
+    T* contents;
+    std::size_t max_size_;
+    std::size_t mask_;  // tamanho do vetor - 1: indice & mask_ da' a volta
+
+    /// head_ e tail_ contam elementos desde a criacao da fila (nao dao a
+    /// volta); cada um fica em sua linha de cache, com a copia local que a
+    /// thread dona guarda do indice da outra, evitando falso compartilhamento
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_{0u};  // consumidor
+    std::size_t tail_cache_{0u};  // ultimo tail_ visto pelo consumidor
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_{0u};  // produtor
+    std::size_t head_cache_{0u};  // ultimo head_ visto pelo produtor
+};
+
+}  // namespace structures
+
+template<typename T>
+structures::SPSCQueue<T>::SPSCQueue() {
+    contents = new T[capacity(DEFAULT_SIZE)];
+    max_size_ = DEFAULT_SIZE;
+    mask_ = capacity(DEFAULT_SIZE) - 1;
+}
+
+template<typename T>
+structures::SPSCQueue<T>::SPSCQueue(std::size_t max) {
+    contents = new T[capacity(max)];
+    max_size_ = max;
+    mask_ = capacity(max) - 1;
+}
+
+template<typename T>
+structures::SPSCQueue<T>::~SPSCQueue() {
+    delete[] contents;
+}
+
+template<typename T>
+void structures::SPSCQueue<T>::enqueue(const T& data) {
+    if (!try_enqueue(data))
+        throw std::out_of_range("Full queue!");
+}
+
+template<typename T>
+T structures::SPSCQueue<T>::dequeue() {
+    T data;
+    if (!try_dequeue(data))
+        throw std::out_of_range("Empty queue!");
+
+    return data;
+}
+
+template<typename T>
+bool structures::SPSCQueue<T>::try_enqueue(const T& data) {
+    return try_enqueue_bulk(&data, 1) == 1;
+}
+
+template<typename T>
+bool structures::SPSCQueue<T>::try_dequeue(T& data) {
+    return try_dequeue_bulk(&data, 1) == 1;
+}
+
+template<typename T>
+template<typename InputIt>
+std::size_t structures::SPSCQueue<T>::try_enqueue_bulk(InputIt first,
+                                                       std::size_t count) {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ + count > max_size_) {
+        /// So le o indice do consumidor quando a copia local indica fila cheia
+        head_cache_ = head_.load(std::memory_order_acquire);
+        if (tail - head_cache_ + count > max_size_)
+            count = max_size_ - (tail - head_cache_);
+    }
+
+    for (std::size_t i = 0; i < count; i++, ++first)
+        contents[(tail + i) & mask_] = *first;
+
+    /// release: os elementos escritos ficam visiveis antes do novo tail_
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+template<typename T>
+template<typename OutputIt>
+std::size_t structures::SPSCQueue<T>::try_dequeue_bulk(OutputIt out,
+                                                       std::size_t count) {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    if (tail_cache_ - head < count) {
+        /// So le o indice do produtor quando a copia local indica fila vazia
+        tail_cache_ = tail_.load(std::memory_order_acquire);
+        if (tail_cache_ - head < count)
+            count = tail_cache_ - head;
+    }
+
+    for (std::size_t i = 0; i < count; i++, ++out)
+        *out = contents[(head + i) & mask_];
+
+    /// release: as posicoes lidas so sao reescritas depois do novo head_
+    head_.store(head + count, std::memory_order_release);
+    return count;
+}
+
+template<typename T>
+std::size_t structures::SPSCQueue<T>::size() const {
+    /// head_ e' lido antes: tail_ nunca e' menor que um head_ ja observado
+    std::size_t head = head_.load(std::memory_order_acquire);
+    std::size_t tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+template<typename T>
+std::size_t structures::SPSCQueue<T>::max_size() const {
+    return max_size_;
+}
+
+template<typename T>
+bool structures::SPSCQueue<T>::empty() const {
+    return size() == 0;
+}
+
+template<typename T>
+bool structures::SPSCQueue<T>::full() const {
+    return size() == max_size_;
+}
+
+template<typename T>
+std::size_t structures::SPSCQueue<T>::capacity(std::size_t max) {
+    std::size_t capacity = 1;
+    while (capacity < max)
+        capacity <<= 1;
+
+    return capacity;
+}
+
+#endif
@@ -0,0 +1,100 @@
+/// Copyright [2018] <João Fellipe Uller>
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "spsc_queue.hpp"
+
+int main(int argc, char* argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class SPSCQueueTest: public ::testing::Test {
+protected:
+    structures::SPSCQueue<int> queue{10u};
+};
+
+
+TEST_F(SPSCQueueTest, Enqueue) {
+    queue.enqueue(0);
+    ASSERT_EQ(1u, queue.size());
+    queue.enqueue(2);
+    ASSERT_EQ(2u, queue.size());
+    ASSERT_FALSE(queue.empty());
+}
+
+TEST_F(SPSCQueueTest, Dequeue) {
+    for (auto i = 0; i < 10; ++i) {
+        queue.enqueue(i);
+    }
+    for (auto i = 0; i < 10; ++i) {
+        ASSERT_EQ(i, queue.dequeue());
+    }
+    ASSERT_TRUE(queue.empty());
+    ASSERT_THROW(queue.dequeue(), std::out_of_range);
+}
+
+TEST_F(SPSCQueueTest, FullQueue) {
+    for (auto i = 0; i < (int)queue.max_size(); ++i) {
+        ASSERT_TRUE(queue.try_enqueue(i));
+    }
+    ASSERT_TRUE(queue.full());
+    ASSERT_FALSE(queue.try_enqueue(0));
+    ASSERT_THROW(queue.enqueue(0), std::out_of_range);
+}
+
+TEST_F(SPSCQueueTest, WrapAround) {
+    int data;
+    for (auto round = 0; round < 10; ++round) {
+        for (auto i = 0; i < 7; ++i) {
+            ASSERT_TRUE(queue.try_enqueue(round * 10 + i));
+        }
+        for (auto i = 0; i < 7; ++i) {
+            ASSERT_TRUE(queue.try_dequeue(data));
+            ASSERT_EQ(round * 10 + i, data);
+        }
+        ASSERT_FALSE(queue.try_dequeue(data));
+    }
+}
+
+TEST_F(SPSCQueueTest, Bulk) {
+    int in[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    ASSERT_EQ(10u, queue.try_enqueue_bulk(in, 12u));
+    ASSERT_TRUE(queue.full());
+
+    int out[12];
+    ASSERT_EQ(4u, queue.try_dequeue_bulk(out, 4u));
+    ASSERT_EQ(2u, queue.try_enqueue_bulk(in + 10, 2u));
+    ASSERT_EQ(8u, queue.try_dequeue_bulk(out + 4, 12u));
+    for (auto i = 0; i < 12; ++i) {
+        ASSERT_EQ(i, out[i]);
+    }
+}
+
+TEST_F(SPSCQueueTest, ProducerConsumer) {
+    const auto total = 1000000;
+    structures::SPSCQueue<int> channel{1024u};
+
+    std::thread producer([&]() {
+        for (auto i = 0; i < total;) {
+            if (channel.try_enqueue(i))
+                ++i;
+        }
+    });
+
+    std::vector<int> received;
+    received.reserve(total);
+    int batch[64];
+    while ((int)received.size() < total) {
+        auto count = channel.try_dequeue_bulk(batch, 64u);
+        received.insert(received.end(), batch, batch + count);
+    }
+    producer.join();
+
+    for (auto i = 0; i < total; ++i) {
+        ASSERT_EQ(i, received[i]);
+    }
+    ASSERT_TRUE(channel.empty());
+}
@@ -5,9 +5,11 @@
 #include <cstdint>
 #include <stdexcept>
 
+#include "node_allocator.hpp"
+
 namespace structures {
 
-template<typename T>
+template<typename T, template<typename> class Allocator = NewAllocator>
 /// Classe Pilha Encadeada
 class LinkedStack {
  public:
@@ -70,68 +72,69 @@ class LinkedStack {
 
     Node* top_;  // nodo-topo
     std::size_t size_{0};  // tamanho
+    Allocator<Node> allocator_;  // alocador de nodos
 };
 
 }  // namespace structures
 
 #endif
 
-template <typename T>
-structures::LinkedStack<T>::LinkedStack() {
+template <typename T, template<typename> class Allocator>
+structures::LinkedStack<T, Allocator>::LinkedStack() {
     top_ = nullptr;
 }
 
-template <typename T>
-structures::LinkedStack<T>::~LinkedStack() {
+template <typename T, template<typename> class Allocator>
+structures::LinkedStack<T, Allocator>::~LinkedStack() {
     clear();
 }
 
-template <typename T>
-void structures::LinkedStack<T>::clear() {
+template <typename T, template<typename> class Allocator>
+void structures::LinkedStack<T, Allocator>::clear() {
     Node *aux = top_;
     for (unsigned int i = 0; i < size_; i++) {
         Node *next = aux->next();
-        delete aux;
+        allocator_.destroy(aux);
         aux = next;
     }
     size_ = 0;
 }
 
-template <typename T>
-void structures::LinkedStack<T>::push(const T& data) {
-    top_ = new Node(data, top_);
+template <typename T, template<typename> class Allocator>
+void structures::LinkedStack<T, Allocator>::push(const T& data) {
+    top_ = allocator_.create(data, top_);
     size_++;
 }
 
-template <typename T>
-T structures::LinkedStack<T>::pop() {
+template <typename T, template<typename> class Allocator>
+T structures::LinkedStack<T, Allocator>::pop() {
     if (empty())
         throw std::out_of_range("Empty list");
 
     Node *aux = top_;
     T node_data = aux->data();
     top_ = aux->next();
-    delete aux;
+    allocator_.destroy(aux);
     size_--;
     if (size_ == 0)
         top_ = nullptr;
     return node_data;
 }
 
-template <typename T>
-T& structures::LinkedStack<T>::top() const {
+template <typename T, template<typename> class Allocator>
+T& structures::LinkedStack<T, Allocator>::top() const {
     if (empty())
         throw std::out_of_range("Empty list");
 
     return top_->data();
 }
 
-template <typename T>
-bool structures::LinkedStack<T>::empty() const {
+template <typename T, template<typename> class Allocator>
+bool structures::LinkedStack<T, Allocator>::empty() const {
     return size_ == 0;
 }
 
-template <typename T>
-std::size_t structures::LinkedStack<T>::size() const {
+template <typename T, template<typename> class Allocator>
+std::size_t structures::LinkedStack<T, Allocator>::size() const {
     return size_;
 }
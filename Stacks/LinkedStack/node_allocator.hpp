@@ -0,0 +1,206 @@
+/// Copyright [2018] <João Fellipe Uller>
+#ifndef STRUCTURES_NODE_ALLOCATOR_H
+#define STRUCTURES_NODE_ALLOCATOR_H
+
+#include <cstdint>
+#include <memory>  // std::shared_ptr
+#include <new>  // placement new
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#define DEFAULT_SLAB_SIZE 64u
+
+namespace structures {
+
+template<typename Node>
+/// Alocador padrao de nodos: cada nodo e' alocado com new e liberado com delete
+class NewAllocator {
+ public:
+    /// Destruir o alocador nao libera os nodos
+    static constexpr bool bulk_release = false;
+
+    /// Aloca e constroi um nodo
+    template<typename... Args>
+    Node* create(Args&&... args) {
+        return new Node(std::forward<Args>(args)...);
+    }
+
+    /// Destroi e libera um nodo
+    void destroy(Node* node) {
+        delete node;
+    }
+
+    /// Qualquer instancia pode liberar os nodos de outra
+    friend bool operator==(const NewAllocator&, const NewAllocator&) {
+        return true;
+    }
+
+    friend bool operator!=(const NewAllocator&, const NewAllocator&) {
+        return false;
+    }
+};
+
+template<typename Node>
+/// Alocador de nodos em pool
+///
+/// Reserva slabs de DEFAULT_SLAB_SIZE nodos contiguos e reaproveita os nodos
+/// liberados por uma lista livre, sem chamar o alocador do sistema a cada
+/// insercao/remocao. Copias do alocador compartilham o mesmo pool, cuja
+/// memoria e' devolvida quando a ultima copia e' destruida.
+class PoolAllocator {
+ public:
+    /// Nodos liberados voltam a lista livre; estruturas devem libera-los
+    static constexpr bool bulk_release = false;
+
+    PoolAllocator():
+        pool_{std::make_shared<Pool>()}
+    {}
+
+    /// Aloca e constroi um nodo
+    template<typename... Args>
+    Node* create(Args&&... args) {
+        Slot* slot = pool_->allocate();
+        try {
+            return new (slot) Node(std::forward<Args>(args)...);
+        } catch (...) {
+            pool_->deallocate(slot);
+            throw;
+        }
+    }
+
+    /// Destroi um nodo e devolve sua posicao a lista livre
+    void destroy(Node* node) {
+        node->~Node();
+        pool_->deallocate(reinterpret_cast<Slot*>(node));
+    }
+
+    /// Numero de slabs reservados (chamadas ao alocador do sistema)
+    std::size_t slabs() const {
+        return pool_->slabs.size();
+    }
+
+    /// Alocadores iguais compartilham o pool: um pode liberar nodos do outro
+    friend bool operator==(const PoolAllocator& a, const PoolAllocator& b) {
+        return a.pool_ == b.pool_;
+    }
+
+    friend bool operator!=(const PoolAllocator& a, const PoolAllocator& b) {
+        return a.pool_ != b.pool_;
+    }
+
+ private:
+    /// Posicao de um slab: guarda um nodo ou, se livre, a proxima livre
+    union Slot {
+        Slot* next;
+        alignas(Node) unsigned char node[sizeof(Node)];
+    };
+
+    struct Pool {
+        std::vector<Slot*> slabs;
+        Slot* free{nullptr};
+
+        ~Pool() {
+            for (auto slab : slabs)
+                delete[] slab;
+        }
+
+        Slot* allocate() {
+            if (free == nullptr) {
+                Slot* slab = new Slot[DEFAULT_SLAB_SIZE];
+                slabs.push_back(slab);
+                /// Encadeia do fim para o inicio: nodos saem em ordem de endereco
+                for (std::size_t i = DEFAULT_SLAB_SIZE; i > 0; i--) {
+                    slab[i - 1].next = free;
+                    free = &slab[i - 1];
+                }
+            }
+
+            Slot* slot = free;
+            free = slot->next;
+            return slot;
+        }
+
+        void deallocate(Slot* slot) {
+            slot->next = free;
+            free = slot;
+        }
+    };
+
+    std::shared_ptr<Pool> pool_;
+};
+
+template<typename Node>
+/// Alocador de nodos em arena, para estruturas construidas uma vez e
+/// descartadas inteiras
+///
+/// Nodos sao alocados em sequencia (bump) em blocos que dobram de tamanho,
+/// a partir de DEFAULT_SLAB_SIZE nodos. destroy() apenas chama o destrutor:
+/// a memoria so' e' devolvida, toda de uma vez, quando a ultima copia do
+/// alocador e' destruida.
+class ArenaAllocator {
+ public:
+    /// A arena libera todos os nodos; se o destrutor do dado e' trivial, a
+    /// estrutura nem precisa percorre-los
+    static constexpr bool bulk_release = true;
+
+    ArenaAllocator():
+        arena_{std::make_shared<Arena>()}
+    {}
+
+    /// Aloca e constroi um nodo
+    template<typename... Args>
+    Node* create(Args&&... args) {
+        return new (arena_->allocate()) Node(std::forward<Args>(args)...);
+    }
+
+    /// Destroi um nodo (sua memoria fica na arena)
+    void destroy(Node* node) {
+        node->~Node();
+    }
+
+    /// Numero de blocos reservados (chamadas ao alocador do sistema)
+    std::size_t chunks() const {
+        return arena_->chunks.size();
+    }
+
+    /// Alocadores iguais compartilham a arena: um pode liberar nodos do outro
+    friend bool operator==(const ArenaAllocator& a, const ArenaAllocator& b) {
+        return a.arena_ == b.arena_;
+    }
+
+    friend bool operator!=(const ArenaAllocator& a, const ArenaAllocator& b) {
+        return a.arena_ != b.arena_;
+    }
+
+ private:
+    typedef typename std::aligned_storage<sizeof(Node),
+                                          alignof(Node)>::type Storage;
+
+    struct Arena {
+        std::vector<Storage*> chunks;
+        std::size_t used{0u};  // posicoes usadas do ultimo bloco
+        std::size_t capacity{0u};  // tamanho do ultimo bloco
+
+        ~Arena() {
+            for (auto chunk : chunks)
+                delete[] chunk;
+        }
+
+        void* allocate() {
+            if (used == capacity) {
+                capacity = chunks.empty() ? DEFAULT_SLAB_SIZE : 2 * capacity;
+                chunks.push_back(new Storage[capacity]);
+                used = 0;
+            }
+
+            return &chunks.back()[used++];
+        }
+    };
+
+    std::shared_ptr<Arena> arena_;
+};
+
+}  // namespace structures
+
+#endif
@@ -63,3 +63,18 @@ TEST_F(LinkedStackTest, Pop) {
 TEST_F(LinkedStackTest, PopEmpty) {
     ASSERT_THROW(stack.pop(), std::out_of_range);
 }
+
+TEST_F(LinkedStackTest, PoolAllocator) {
+    structures::LinkedStack<int, structures::PoolAllocator> pooled{};
+    for (auto round = 0; round < 10; ++round) {
+        for (auto i = 0; i < 100; ++i) {
+            pooled.push(i);
+        }
+        ASSERT_EQ(100u, pooled.size());
+        for (auto i = 0; i < 100; ++i) {
+            ASSERT_EQ(99 - i, pooled.pop());
+        }
+        ASSERT_TRUE(pooled.empty());
+    }
+    pooled.push(1);
+}
@@ -0,0 +1,175 @@
+/// Copyright [2018] <João Fellipe Uller>
+#ifndef STRUCTURES_HAZARD_POINTER_H
+#define STRUCTURES_HAZARD_POINTER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#define HAZARD_POINTERS_PER_THREAD 2u
+#define RETIRED_SCAN_THRESHOLD 64u
+
+namespace structures {
+
+/// Hazard pointers: recuperacao segura de memoria para estruturas sem locks
+///
+/// Antes de acessar um nodo compartilhado, a thread o publica em um de seus
+/// slots (protect). Nodos removidos da estrutura nao sao apagados na hora:
+/// sao aposentados (retire) e so' sao apagados quando nenhuma thread os
+/// publica. Isso tambem impede o problema ABA, pois um nodo protegido nao
+/// pode ser liberado e realocado no mesmo endereco.
+class HazardPointers {
+ public:
+    /// Publica no slot o ponteiro lido de source e o retorna, garantindo que
+    /// ele ainda estava em source depois de publicado
+    template<typename U>
+    static U* protect(std::size_t slot, const std::atomic<U*>& source) {
+        std::atomic<void*>& hazard = state().record->pointers[slot];
+        U* pointer = source.load(std::memory_order_acquire);
+        while (true) {
+            hazard.store(pointer);
+            U* current = source.load(std::memory_order_acquire);
+            if (current == pointer)
+                return pointer;
+            pointer = current;
+        }
+    }
+
+    /// Libera o slot
+    static void clear(std::size_t slot) {
+        state().record->pointers[slot].store(nullptr,
+                                             std::memory_order_release);
+    }
+
+    /// Aposenta um nodo ja retirado da estrutura; sera apagado com delete
+    /// quando nenhuma thread o proteger
+    template<typename U>
+    static void retire(U* pointer) {
+        ThreadState& thread = state();
+        thread.retired.push_back(Retired{pointer, &destroy<U>});
+        if (thread.retired.size() >= RETIRED_SCAN_THRESHOLD)
+            scan(thread);
+    }
+
+ private:
+    /// Slots de uma thread; registros sao reaproveitados e nunca apagados
+    struct Record {
+        std::atomic<bool> active{false};
+        std::atomic<void*> pointers[HAZARD_POINTERS_PER_THREAD];
+        Record* next{nullptr};
+
+        Record() {
+            for (auto& pointer : pointers)
+                pointer.store(nullptr, std::memory_order_relaxed);
+        }
+    };
+
+    /// Nodo aposentado e a funcao que o apaga
+    struct Retired {
+        void* pointer;
+        void (*deleter)(void*);
+    };
+
+    /// Estado local de cada thread: seu registro e seus nodos aposentados
+    struct ThreadState {
+        Record* record;
+        std::vector<Retired> retired;
+
+        ThreadState():
+            record{acquire_record()}
+        {}
+
+        ~ThreadState() {
+            for (auto& pointer : record->pointers)
+                pointer.store(nullptr, std::memory_order_release);
+            scan(*this);
+
+            /// O que ainda esta protegido por outra thread fica como orfao
+            if (!retired.empty()) {
+                std::lock_guard<std::mutex> lock(orphans_mutex());
+                orphans().insert(orphans().end(), retired.begin(),
+                                 retired.end());
+            }
+            record->active.store(false, std::memory_order_release);
+        }
+    };
+
+    template<typename U>
+    static void destroy(void* pointer) {
+        delete static_cast<U*>(pointer);
+    }
+
+    static ThreadState& state() {
+        static thread_local ThreadState state;
+        return state;
+    }
+
+    static std::atomic<Record*>& records() {
+        static std::atomic<Record*> head{nullptr};
+        return head;
+    }
+
+    static std::mutex& orphans_mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::vector<Retired>& orphans() {
+        static std::vector<Retired> orphans;
+        return orphans;
+    }
+
+    /// Reaproveita o registro de uma thread que terminou ou cria um novo
+    static Record* acquire_record() {
+        for (Record* record = records().load(std::memory_order_acquire);
+             record != nullptr; record = record->next) {
+            bool inactive = false;
+            if (record->active.compare_exchange_strong(inactive, true))
+                return record;
+        }
+
+        Record* record = new Record();
+        record->active.store(true, std::memory_order_relaxed);
+        record->next = records().load(std::memory_order_relaxed);
+        while (!records().compare_exchange_weak(record->next, record)) {}
+        return record;
+    }
+
+    /// Apaga os nodos aposentados que nenhuma thread protege
+    static void scan(ThreadState& thread) {
+        {
+            std::lock_guard<std::mutex> lock(orphans_mutex());
+            thread.retired.insert(thread.retired.end(), orphans().begin(),
+                                  orphans().end());
+            orphans().clear();
+        }
+
+        std::vector<void*> hazards;
+        for (Record* record = records().load(std::memory_order_acquire);
+             record != nullptr; record = record->next) {
+            for (auto& pointer : record->pointers) {
+                void* hazard = pointer.load();
+                if (hazard != nullptr)
+                    hazards.push_back(hazard);
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        std::vector<Retired> still_retired;
+        for (auto& retired : thread.retired) {
+            if (std::binary_search(hazards.begin(), hazards.end(),
+                                   retired.pointer))
+                still_retired.push_back(retired);
+            else
+                retired.deleter(retired.pointer);
+        }
+        thread.retired.swap(still_retired);
+    }
+};
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,163 @@
+/// Copyright [2018] <João Fellipe Uller>
+#ifndef STRUCTURES_LOCK_FREE_STACK_HPP
+#define STRUCTURES_LOCK_FREE_STACK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "hazard_pointer.hpp"
+
+namespace structures {
+
+template<typename T>
+/// Pilha encadeada concorrente e sem locks (pilha de Treiber)
+///
+/// O topo e' trocado com CAS. O nodo lido em pop fica protegido por um
+/// hazard pointer ate o CAS, entao nao pode ser liberado e realocado no
+/// mesmo endereco nesse meio tempo (problema ABA).
+class LockFreeStack {
+ public:
+    /// Construtor/Destrutor
+    LockFreeStack();
+
+    ~LockFreeStack();
+
+    LockFreeStack(const LockFreeStack&) = delete;
+    LockFreeStack& operator=(const LockFreeStack&) = delete;
+
+    /// Limpa pilha
+    void clear();
+
+    /// Empilha elemento
+    void push(const T& data);
+
+    /// Desempilha elemento
+    T pop();
+
+    /// Tenta desempilhar para data; retorna false se a pilha esta vazia
+    bool try_pop(T& data);
+
+    /// Retorna uma copia do topo da pilha (outra thread pode desempilha-lo)
+    T top() const;
+
+    /// Testa pilha vazia
+    bool empty() const;
+
+    /// Tamanho da pilha (aproximado se ha acesso concorrente)
+    std::size_t size() const;
+
+ private:
+    class Node {
+     public:
+        explicit Node(const T& data):
+            data_{data}
+        {}
+
+        T& data() {  // getter: info
+            return data_;
+        }
+
+        Node* next() {  // getter: próximo
+            return next_;
+        }
+
+        void next(Node* next) {  // setter: próximo
+            next_ = next;
+        }
+
+     private:
+        T data_;
+        Node* next_{nullptr};
+    };
+
+    std::atomic<Node*> top_{nullptr};  // nodo-topo
+    std::atomic<std::size_t> size_{0u};  // tamanho
+};
+
+}  // namespace structures
+
+#endif
+
+template <typename T>
+structures::LockFreeStack<T>::LockFreeStack() {
+}
+
+template <typename T>
+structures::LockFreeStack<T>::~LockFreeStack() {
+    Node *aux = top_.load();
+    while (aux != nullptr) {
+        Node *next = aux->next();
+        delete aux;
+        aux = next;
+    }
+}
+
+template <typename T>
+void structures::LockFreeStack<T>::clear() {
+    T data;
+    while (try_pop(data)) {}
+}
+
+template <typename T>
+void structures::LockFreeStack<T>::push(const T& data) {
+    Node *node = new Node(data);
+    Node *top = top_.load(std::memory_order_relaxed);
+    do {
+        node->next(top);
+    } while (!top_.compare_exchange_weak(top, node,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed));
+    size_.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+T structures::LockFreeStack<T>::pop() {
+    T data;
+    if (!try_pop(data))
+        throw std::out_of_range("Empty stack");
+
+    return data;
+}
+
+template <typename T>
+bool structures::LockFreeStack<T>::try_pop(T& data) {
+    Node *top;
+    do {
+        top = HazardPointers::protect(0, top_);
+        if (top == nullptr) {
+            HazardPointers::clear(0);
+            return false;
+        }
+    } while (!top_.compare_exchange_weak(top, top->next()));
+
+    HazardPointers::clear(0);
+    data = std::move(top->data());
+    HazardPointers::retire(top);
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename T>
+T structures::LockFreeStack<T>::top() const {
+    Node *top = HazardPointers::protect(0, top_);
+    if (top == nullptr) {
+        HazardPointers::clear(0);
+        throw std::out_of_range("Empty stack");
+    }
+
+    T data = top->data();
+    HazardPointers::clear(0);
+    return data;
+}
+
+template <typename T>
+bool structures::LockFreeStack<T>::empty() const {
+    return top_.load(std::memory_order_acquire) == nullptr;
+}
+
+template <typename T>
+std::size_t structures::LockFreeStack<T>::size() const {
+    return size_.load(std::memory_order_relaxed);
+}
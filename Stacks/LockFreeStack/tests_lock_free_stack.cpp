@@ -0,0 +1,94 @@
+/// Copyright [2018] <João Fellipe Uller>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lock_free_stack.hpp"
+
+int main(int argc, char* argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class LockFreeStackTest: public ::testing::Test {
+protected:
+    structures::LockFreeStack<int> stack{};
+};
+
+
+TEST_F(LockFreeStackTest, Push) {
+    stack.push(0);
+    ASSERT_EQ(1u, stack.size());
+    ASSERT_EQ(0, stack.top());
+
+    stack.push(2);
+    ASSERT_EQ(2, stack.top());
+    stack.push(-1);
+    ASSERT_EQ(-1, stack.top());
+    ASSERT_EQ(3u, stack.size());
+}
+
+TEST_F(LockFreeStackTest, Pop) {
+    for (auto i = 0; i < 10; ++i) {
+        stack.push(i);
+    }
+    for (auto i = 9; i >= 0; --i) {
+        ASSERT_EQ(i, stack.pop());
+    }
+    ASSERT_TRUE(stack.empty());
+}
+
+TEST_F(LockFreeStackTest, EmptyStack) {
+    int data;
+    ASSERT_FALSE(stack.try_pop(data));
+    ASSERT_THROW(stack.pop(), std::out_of_range);
+    ASSERT_THROW(stack.top(), std::out_of_range);
+}
+
+TEST_F(LockFreeStackTest, Clear) {
+    for (auto i = 0; i < 10; ++i) {
+        stack.push(i);
+    }
+    stack.clear();
+    ASSERT_TRUE(stack.empty());
+    ASSERT_EQ(0u, stack.size());
+}
+
+/// Usa a pilha como lista livre de buffers: cada thread retira um buffer,
+/// o usa e devolve; nenhum buffer pode estar com duas threads ao mesmo tempo
+TEST_F(LockFreeStackTest, StressFreeList) {
+    const auto buffers = 16;
+    const auto threads_count = 8;
+    const auto rounds = 20000;
+
+    std::vector<std::atomic<int>> owners(buffers);
+    for (auto i = 0; i < buffers; ++i) {
+        owners[i].store(0);
+        stack.push(i);
+    }
+
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < threads_count; ++t) {
+        threads.emplace_back([&]() {
+            int buffer;
+            for (auto i = 0; i < rounds; ++i) {
+                if (!stack.try_pop(buffer))
+                    continue;
+                if (owners[buffer].fetch_add(1) != 0)
+                    failed.store(true);
+                owners[buffer].fetch_sub(1);
+                stack.push(buffer);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_FALSE(failed.load());
+    ASSERT_EQ(static_cast<std::size_t>(buffers), stack.size());
+}
@@ -3,19 +3,152 @@
 #define AVL_TREE_HPP
 
 #include <algorithm>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include "array_list.hpp"
+#include "frozen_tree.hpp"
+#include "node_allocator.hpp"
+
+#define AVL_MAX_HEIGHT 96u
+#define AVL_PARALLEL_HEIGHT 12
 
 namespace structures {
 
-template <typename T>
+template<bool Ranked>
+/// Tamanho da subarvore de um no': so' existe nas arvores com posto
+struct AVLSubtreeSize {};
+
+template<>
+struct AVLSubtreeSize<true> {
+    std::size_t count_{1u};
+};
+
+template <typename T, template<typename> class Allocator = NewAllocator,
+          bool Ranked = false>
 /// Implementa uma arvore binaria AVL
+///
+/// Com Ranked, cada no' guarda tambem o tamanho de sua subarvore, o que
+/// permite consultas por posto (rank, select, count_range) em O(log n)
 class AVLTree {
+    struct Node;
+    class Iterator;
+    class Range;
+
 public:
+    /// Iterador em ordem; os dados sao constantes (mudar um dado poderia
+    /// desordenar a arvore)
+    typedef Iterator iterator;
+    typedef Iterator const_iterator;
+
+    /// Construtor padrao
+    AVLTree() = default;
+
+    /// Construtor de copia: reconstroi a arvore ja balanceada, em O(n)
+    AVLTree(const AVLTree& other);
+
+    /// Construtor de movimento
+    AVLTree(AVLTree&& other);
+
     /// Destrutor
     ~AVLTree();
 
-    /// Insere um dado na arvore
-    void insert(const T& data);
+    /// Atribuicao por copia ou movimento
+    AVLTree& operator=(AVLTree other);
+
+    /// Constroi a arvore a partir de dados em ordem crescente, em O(n) e sem
+    /// rotacoes: os nodos sao encadeados numa unica passada e depois montados
+    /// numa arvore perfeitamente balanceada. Dados repetidos sao ignorados;
+    /// dados fora de ordem lancam std::invalid_argument
+    template<typename InputIt>
+    static AVLTree from_sorted(InputIt first, InputIt last);
+
+    /// Uniao: insere os dados de other que faltam nesta arvore, intercalando
+    /// as duas em ordem e reconstruindo, em O(n + m)
+    void merge(const AVLTree& other);
+
+    /// Operacoes de conjunto por juncao (join) e divisao (split), em
+    /// O(m log(n/m + 1)) para arvores de tamanhos m <= n. As duas metades da
+    /// recursao rodam em paralelo (std::async), ate um nivel por nucleo,
+    /// enquanto as subarvores tem altura de ao menos AVL_PARALLEL_HEIGHT.
+    /// other fica vazia: seus nodos sao reaproveitados quando os alocadores
+    /// sao iguais (senao, os dados sao copiados)
+
+    /// Uniao: insere os dados de other que faltam nesta arvore
+    void merge(AVLTree&& other);
+
+    /// Interseccao: mantem apenas os dados que tambem estao em other
+    void intersect(AVLTree&& other);
+
+    /// Diferenca: remove os dados que estao em other
+    void subtract(AVLTree&& other);
+
+    /// Divide a arvore em O(log n): less recebe os dados menores que data e
+    /// greater, os maiores (com Ranked; sem, contar os tamanhos custa
+    /// O(min(|less|, |greater|))). Retorna se data existia; esta arvore fica
+    /// vazia
+    bool split(const T& data, AVLTree& less, AVLTree& greater);
+
+    /// Junta data e os dados de greater ao fim desta arvore, em O(log n).
+    /// Os dados desta arvore devem ser menores que data e os de greater,
+    /// maiores (senao, std::invalid_argument)
+    void join(const T& data, AVLTree&& greater);
+
+    /// Remove todos os dados
+    void clear();
+
+    /// Copia imutavel e contigua da arvore, para buscas com menos faltas de
+    /// cache (ver FrozenTree), em O(n)
+    FrozenTree<T> freeze() const;
+
+    /// Insere um dado na arvore, numa unica descida; retorna se o dado era
+    /// novo (se ja existia, a arvore nao muda)
+    bool insert(const T& data);
+
+    /// Constroi um dado a partir de args e o insere se ainda nao existe um
+    /// equivalente. Retorna o iterador para o dado na arvore e se inseriu
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(Args&&... args);
+
+    /// Insere o dado ou, se ja existe um equivalente, o substitui. Retorna o
+    /// iterador para o dado e se inseriu
+    std::pair<iterator, bool> insert_or_assign(const T& data);
+
+    /// Iterador para o dado, ou end() se ele nao existe
+    iterator find(const T& data) const;
+
+    /// Navegacao ordenada, em O(log n); os iteradores valem end() quando
+    /// nao ha tal dado
+
+    /// Primeiro dado nao menor que data
+    iterator lower_bound(const T& data) const;
+
+    /// Primeiro dado maior que data
+    iterator upper_bound(const T& data) const;
+
+    /// Maior dado nao maior que data
+    iterator floor(const T& data) const;
+
+    /// Menor dado nao menor que data
+    iterator ceiling(const T& data) const;
+
+    /// Menor e maior dado
+    const T& min() const;
+    const T& max() const;
+
+    /// Dados em [lo, hi], em ordem: percorre-los custa O(log n + k), sem
+    /// visitar os nos fora do intervalo
+    Range range(const T& lo, const T& hi) const;
+
+    /// Iterador para o menor dado
+    iterator begin() const;
+
+    /// Iterador para depois do maior dado
+    iterator end() const;
 
     /// Remove um dado da arvore
     void remove(const T& data);
@@ -29,6 +162,28 @@ public:
     /// Retorna o numero de elementos da arvore
     std::size_t size() const;
 
+    /// Consultas por posto (apenas com Ranked), em O(log n)
+
+    /// Numero de dados menores que data
+    std::size_t rank(const T& data) const;
+
+    /// Dado de posto k (o k-esimo menor, a partir de 0)
+    const T& select(std::size_t k) const;
+
+    /// Numero de dados em [lo, hi]
+    std::size_t count_range(const T& lo, const T& hi) const;
+
+    /// Percursos sem alocacao: chamam visit(dado) para cada dado, na ordem
+    /// do percurso, usando uma pilha de tamanho fixo (a altura e' limitada)
+    template<typename Visitor>
+    void visit_pre_order(Visitor&& visit) const;
+
+    template<typename Visitor>
+    void visit_in_order(Visitor&& visit) const;
+
+    template<typename Visitor>
+    void visit_post_order(Visitor&& visit) const;
+
     /// Retorna a arvore percorrida em pre-ordem
     ArrayList<T> pre_order() const;
 
@@ -39,386 +194,1327 @@ public:
     ArrayList<T> post_order() const;
 
 private:
-    struct Node {
+    struct Node: AVLSubtreeSize<Ranked> {
         T data_;
-        std::size_t height_{0u};
+        int height_{1};  // folha: 1
         Node* left_{nullptr};
         Node* right_{nullptr};
 
-        explicit Node(const T& data) {
-            data_ = data;
+        explicit Node(const T& data):
+            data_{data}
+        {}
+
+        explicit Node(T&& data):
+            data_{std::move(data)}
+        {}
+
+        /// METODOS AUXILIARES
+        /// Retorna o menor valor da subarvore
+        const T& minimun() const {
+            const Node *node = this;
+            while (node->left_ != nullptr)
+                node = node->left_;
+            return node->data_;
         }
 
-        void insert(const T& data) {
-            if (data < data_) {
-                if (left_ == nullptr)
-                    left_ = new Node(data);
-                else
-                    left_->insert(data);
-            } else {
-                if (right_ == nullptr)
-                    right_ = new Node(data);
-                else
-                    right_->insert(data);
-            }
+        /// Retorna o maior valor da subarvore
+        const T& maximun() const {
+            const Node *node = this;
+            while (node->right_ != nullptr)
+                node = node->right_;
+            return node->data_;
+        }
+    };
 
-            updateHeight();
-
-            int fb_node = fb();
-            int sqrd_fb = fb_node * fb_node;
-            if (sqrd_fb > 1) {  // No' desbalanceado
-                if (fb_node > 0) {
-                    if (left_->fb() > 0)
-                        left_ = simpleRight();
-                    else
-                        left_ = doubleRight();
-                } else {
-                    if (right_->fb() > 0)
-                        right_ = simpleLeft();
-                    else
-                        right_ = doubleLeft();
-                }
-            }
+    /// Caminho da raiz ate um no': enderecos dos ponteiros que levam a cada
+    /// no', para que o rebalanceamento troque a subarvore no lugar. A altura
+    /// de uma AVL com n nos e' no maximo ~1.44 log2(n), logo AVL_MAX_HEIGHT
+    /// basta para qualquer n enderecavel
+    struct Path {
+        Node** links[AVL_MAX_HEIGHT];
+        std::size_t depth{0u};
+
+        void push(Node** link) {
+            links[depth++] = link;
         }
+    };
 
-        bool remove(const T& data) {
-            if ((data > data_) && (right_ != nullptr)) {
-                if (!right_->remove(data)) {
-                    delete right_;
-                    right_ = nullptr;
-                }
-            } else if ((data < data_) && (left_ != nullptr)) {
-                if (!left_->remove(data)) {
-                    delete left_;
-                    left_ = nullptr;
-                }
-            } else {
-                if ((right_ != nullptr) && (left_ != nullptr)) {
-                    data_ = right_->minimun();
-                    right_->remove(data_);
-                } else if (right_ != nullptr) {
-                    data_ = right_->data_;
-                    right_->remove(data_);
-                } else if (left_ != nullptr) {
-                    data_ = left_->data_;
-                    left_->remove(data_);
-                } else {
-                    return false;
-                }
-            }
+    /// Iterador bidirecional: guarda o caminho da raiz ate o no' corrente
+    /// (nenhum no' guarda o pai), e avanca em O(1) amortizado
+    class Iterator {
+     public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
 
-            updateHeight();
-            int fb_node = fb();
-            int sqrd_fb = fb_node * fb_node;
-            while (sqrd_fb > 1) {  // No' desbalanceado
-                if (fb_node > 0) {
-                    if (left_->fb() > 0)
-                        left_ = simpleRight();
-                    else
-                        left_ = doubleRight();
-                } else {
-                    if (right_->fb() > 0)
-                        right_ = simpleLeft();
-                    else
-                        right_ = doubleLeft();
-                }
-
-                updateHeight();
-                fb_node = fb();
-                sqrd_fb = fb_node * fb_node;
-            }
+        Iterator() = default;
 
-            return true;
+        reference operator*() const {
+            return path_[depth_ - 1]->data_;
         }
 
-        bool contains(const T& data) const {
-            if (data == data_) {
-                return true;
-            } else {
-                if ((data < data_) && (left_ != nullptr))
-                    return left_->contains(data);
-                else if (right_ != nullptr)
-                    return right_->contains(data);
-                else
-                    return false;
+        pointer operator->() const {
+            return &path_[depth_ - 1]->data_;
+        }
+
+        Iterator& operator++() {
+            const Node *node = path_[depth_ - 1];
+            if (node->right_ != nullptr) {  // menor da subarvore direita
+                path_[depth_++] = node->right_;
+                leftmost();
+            } else {  // sobe ate vir de um filho esquerdo
+                const Node *child;
+                do {
+                    child = path_[--depth_];
+                } while ((depth_ > 0) && (path_[depth_ - 1]->left_ != child));
             }
+            return *this;
         }
 
-        void updateHeight() {
-            if ((left_ != nullptr) && (right_ != nullptr)) {
-                height_ = max(left_->height_, right_->height_);
-            } else if (left_ != nullptr) {
-                height_ = left_->height_;
-            } else if (right_ != nullptr) {
-                height_ = right_->height_;
-            } else {
-                height_ = 0;
+        Iterator operator++(int) {
+            Iterator old{*this};
+            ++*this;
+            return old;
+        }
+
+        Iterator& operator--() {
+            if (depth_ == 0) {  // end(): maior dado
+                path_[depth_++] = tree_->root_;
+                rightmost();
+                return *this;
             }
+
+            const Node *node = path_[depth_ - 1];
+            if (node->left_ != nullptr) {  // maior da subarvore esquerda
+                path_[depth_++] = node->left_;
+                rightmost();
+            } else {  // sobe ate vir de um filho direito
+                const Node *child;
+                do {
+                    child = path_[--depth_];
+                } while ((depth_ > 0) && (path_[depth_ - 1]->right_ != child));
+            }
+            return *this;
         }
 
-        Node* simpleLeft() {
-            Node* aux = right_;
-            aux->left_ = this;
-            right_ = right_->left_;
-            aux->updateHeight();
-            aux->left_->updateHeight();
-            aux->right_->updateHeight();
-            return aux;
+        Iterator operator--(int) {
+            Iterator old{*this};
+            --*this;
+            return old;
         }
 
-        Node* simpleRight() {
-            Node* aux = left_;
-            aux->right_ = this;
-            left_ = left_->right_;
-            aux->updateHeight();
-            aux->left_->updateHeight();
-            aux->right_->updateHeight();
-            return aux;
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            return a.node() == b.node();
         }
 
-        Node* doubleLeft() {
-            right_ = right_->simpleRight();
-            return simpleLeft();
+        friend bool operator!=(const Iterator& a, const Iterator& b) {
+            return a.node() != b.node();
         }
 
-        Node* doubleRight() {
-            left_ = left_->simpleLeft();
-            return simpleRight();
+     private:
+        friend class AVLTree;
+
+        explicit Iterator(const AVLTree* tree):
+            tree_{tree}
+        {}
+
+        const Node* node() const {
+            return (depth_ == 0) ? nullptr : path_[depth_ - 1];
         }
 
-        void pre_order(ArrayList<T>& v) const {
-            v.push_back(data_);
-            if (left_ != nullptr)
-                left_->pre_order(v);
-            if (right_ != nullptr)
-                right_->pre_order(v);
+        void leftmost() {  // desce a esquerda a partir do no' corrente
+            const Node *node = path_[depth_ - 1];
+            while (node->left_ != nullptr) {
+                node = node->left_;
+                path_[depth_++] = node;
+            }
         }
 
-        void in_order(ArrayList<T>& v) const {
-            if (left_ != nullptr)
-                left_->in_order(v);
-            v.push_back(data_);
-            if (right_ != nullptr)
-                right_->in_order(v);
+        void rightmost() {  // desce a direita a partir do no' corrente
+            const Node *node = path_[depth_ - 1];
+            while (node->right_ != nullptr) {
+                node = node->right_;
+                path_[depth_++] = node;
+            }
         }
 
-        void post_order(ArrayList<T>& v) const {
-            if (left_ != nullptr)
-                left_->post_order(v);
-            if (right_ != nullptr)
-                right_->post_order(v);
-            v.push_back(data_);
+        const AVLTree* tree_{nullptr};
+        const Node* path_[AVL_MAX_HEIGHT];
+        std::size_t depth_{0u};
+    };
+
+    /// Intervalo [first, last) de iteradores, para uso em range-for
+    class Range {
+     public:
+        iterator begin() const {
+            return first_;
         }
 
-        /// METODOS AUXILIARES
-        /// Retorna o menor valor da subarvore
-        T minimun() {
-            if (left_ == nullptr)
-                return data_;
-            else
-                return left_->minimun();
+        iterator end() const {
+            return last_;
         }
 
-        /// Retorna o maior entre dois inteiros
-        int max(int data1, int data2) {
-            if (data1 >= data2)
-                return data1;
-            else
-                return data2;
+        bool empty() const {
+            return first_ == last_;
         }
 
-        /// Retorna o fator de balanceamento do no'
-        int fb() {
-            if ((left_ != nullptr) && (right_ != nullptr))
-                return left_->height_ - right_->height_;
-            else if (left_ != nullptr)
-                return left_->height_;
-            else if (right_ != nullptr)
-                return 0 - right_->height_;
-            else
-                return 0;
+     private:
+        friend class AVLTree;
+
+        Range(const iterator& first, const iterator& last):
+            first_{first},
+            last_{last}
+        {}
+
+        iterator first_;
+        iterator last_;
+    };
+
+    /// Desce ate o dado, guardando o caminho; retorna o ponteiro que aponta
+    /// para ele (ou o ponteiro nulo onde ele seria inserido)
+    Node** descend(const T& data, Path& path);
+
+    /// Insere um nodo novo no ponteiro nulo ao fim do caminho e rebalanceia
+    template<typename U>
+    Node* link_new(Node** link, Path& path, U&& data);
+
+    /// Altura de uma subarvore (vazia: 0)
+    static int height(const Node* node);
+
+    /// Recalcula a altura (e o tamanho, com Ranked) do no' a partir dos
+    /// filhos
+    static void update_height(Node* node);
+
+    /// Tamanho de uma subarvore (apenas com Ranked; vazia: 0)
+    static std::size_t count(const Node* node);
+
+    /// Recalcula o tamanho da subarvore (nada sem Ranked)
+    static void update_count(Node* node, std::true_type ranked);
+    static void update_count(Node* node, std::false_type ranked);
+
+    /// Numero de dados menores (ou, com inclusive, nao maiores) que data
+    std::size_t count_below(const T& data, bool inclusive) const;
+
+    /// Iterador para o primeiro dado nao contado por count_below
+    iterator first_after(const T& data, bool inclusive) const;
+
+    /// Iterador para o ultimo dado contado por count_below
+    iterator last_before(const T& data, bool inclusive) const;
+
+    /// Encadeia dados em ordem crescente e monta a arvore (que deve estar
+    /// vazia) com eles
+    template<typename InputIt>
+    void build_sorted(InputIt first, InputIt last);
+
+    /// Desmonta a arvore numa lista em ordem, encadeada por right_, em O(n)
+    /// e sem pilha (rotacionando a direita); retorna a cabeca
+    static Node* flatten(Node* root);
+
+    /// Monta uma arvore perfeitamente balanceada com os n primeiros nodos
+    /// da lista encadeada por right_ (que avanca), em O(n)
+    static Node* build(Node*& list, std::size_t n);
+
+    /// Nodos descartados pelas operacoes de conjunto, encadeados por right_:
+    /// sao liberados so' ao fim, pois o alocador nao e' thread-safe
+    struct Garbage {
+        Node* head{nullptr};
+        Node** tail{&head};
+        std::size_t size{0u};
+
+        Garbage() = default;
+        Garbage(const Garbage&) = delete;
+        Garbage& operator=(const Garbage&) = delete;
+
+        void push(Node* node) {
+            node->right_ = nullptr;
+            *tail = node;
+            tail = &node->right_;
+            ++size;
+        }
+
+        void push_tree(Node* root) {
+            for (Node *node = flatten(root); node != nullptr; node = node->right_) {
+                *tail = node;
+                tail = &node->right_;
+                ++size;
+            }
+        }
+
+        void append(Garbage& other) {
+            if (other.head == nullptr)
+                return;
+
+            *tail = other.head;
+            tail = other.tail;
+            size += other.size;
         }
     };
 
+    /// Operacao de conjunto sobre subarvores; consome as duas
+    typedef Node* (*SetOperation)(Node*, Node*, Garbage&, unsigned);
+
+    /// Arvore com o alocador desta e os dados de other (religados se os
+    /// alocadores sao iguais, senao copiados); other fica vazia
+    AVLTree adopt(AVLTree& other);
+
+    /// Aplica uma operacao de conjunto e libera os nodos descartados
+    void apply(SetOperation operation, AVLTree& other);
+
+    /// Libera os nodos descartados
+    void release(Garbage& garbage);
+
+    /// Niveis da recursao que ainda criam tarefas: log2 do numero de nucleos
+    static unsigned spawn_depth();
+
+    /// Junta left, middle e right (left < middle < right), em
+    /// O(|altura(left) - altura(right)|); retorna a nova raiz
+    static Node* join_nodes(Node* left, Node* middle, Node* right);
+
+    /// Juncao descendo pela direita de left (mais alta) ou pela esquerda de
+    /// right (mais alta)
+    static Node* join_right(Node* left, Node* middle, Node* right);
+    static Node* join_left(Node* left, Node* middle, Node* right);
+
+    /// Juncao sem no' do meio: usa o maior no' de left
+    static Node* join_pair(Node* left, Node* right);
+
+    /// Separa o maior no' da subarvore; retorna a raiz do restante
+    static Node* split_last(Node* root, Node*& last);
+
+    /// Divide a subarvore em menores e maiores que data; retorna o no' com
+    /// data, desligado, ou nulo
+    static Node* split_nodes(Node* root, const T& data, Node*& less,
+                             Node*& greater);
+
+    /// Tamanhos das partes de um split
+    static void count_parts(AVLTree& less, AVLTree& greater, std::size_t total,
+                            std::true_type ranked);
+    static void count_parts(AVLTree& less, AVLTree& greater, std::size_t total,
+                            std::false_type ranked);
+
+    /// Aplica a operacao as metades esquerdas e as direitas, em paralelo se
+    /// ainda ha niveis de tarefas e as subarvores sao grandes
+    static void halves(SetOperation operation, Node* a_left, Node* b_left,
+                       Node*& left, Node* a_right, Node* b_right, Node*& right,
+                       Garbage& garbage, unsigned spawn);
+
+    /// Uniao, interseccao e diferenca (a - b) de subarvores
+    static Node* unite_nodes(Node* a, Node* b, Garbage& garbage,
+                             unsigned spawn);
+    static Node* intersect_nodes(Node* a, Node* b, Garbage& garbage,
+                                 unsigned spawn);
+    static Node* subtract_nodes(Node* a, Node* b, Garbage& garbage,
+                                unsigned spawn);
+
+    /// Rotacoes: retornam a nova raiz da subarvore
+    static Node* rotate_left(Node* node);
+    static Node* rotate_right(Node* node);
+
+    /// Rebalanceia a subarvore em *link; retorna se sua altura mudou
+    static bool rebalance(Node** link);
+
+    /// Rebalanceia de baixo para cima os nos do caminho, parando assim que
+    /// a altura de uma subarvore nao muda mais
+    static void rebalance_path(Path& path);
+
     Node* root_{nullptr};
     std::size_t size_{0u};
+    Allocator<Node> allocator_;  // alocador de nodos
 };
 
+template <typename T, template<typename> class Allocator = NewAllocator>
+/// Arvore AVL com consultas por posto
+using RankedAVLTree = AVLTree<T, Allocator, true>;
+
 }  // namespace structures
 
 /// IMPLEMENTACAO DOS METODOS DE AVL_TREE
 
-template <typename T>
-structures::AVLTree<T>::~AVLTree() {
-    while (size_ > 0) {
-        Node *aux = root_;
-        while ((aux->left_ != nullptr) || (aux->right_ != nullptr)) {
-            if (aux->left_ != nullptr)
-                aux = aux->left_;
-            else
-                aux = aux->right_;
+template <typename T, template<typename> class Allocator, bool Ranked>
+structures::AVLTree<T, Allocator, Ranked>::AVLTree(const AVLTree& other):
+    allocator_{other.allocator_}
+{
+    /// O destrutor nao roda se o construtor lanca excecao
+    try {
+        build_sorted(other.begin(), other.end());
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+structures::AVLTree<T, Allocator, Ranked>::AVLTree(AVLTree&& other):
+    root_{other.root_},
+    size_{other.size_},
+    allocator_{other.allocator_}
+{
+    other.root_ = nullptr;
+    other.size_ = 0;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+structures::AVLTree<T, Allocator, Ranked>::~AVLTree() {
+    clear();
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+structures::AVLTree<T, Allocator, Ranked>&
+structures::AVLTree<T, Allocator, Ranked>::operator=(AVLTree other) {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(allocator_, other.allocator_);
+    return *this;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+template<typename InputIt>
+structures::AVLTree<T, Allocator, Ranked>
+structures::AVLTree<T, Allocator, Ranked>::from_sorted(InputIt first,
+                                                       InputIt last) {
+    AVLTree tree;
+    tree.build_sorted(first, last);
+    return tree;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+template<typename InputIt>
+void structures::AVLTree<T, Allocator, Ranked>::build_sorted(InputIt first,
+                                                             InputIt last) {
+    /// Enquanto encadeados, os nodos formam uma arvore degenerada a direita:
+    /// se um dado lancar excecao, clear() ainda libera todos eles
+    Node **tail = &root_;
+    Node *back = nullptr;
+    for (; first != last; ++first) {
+        if ((back != nullptr) && !(back->data_ < *first)) {
+            if (*first < back->data_)
+                throw std::invalid_argument("Unsorted input");
+            continue;
         }
 
-        aux->remove(aux->data_);
-        size_--;
+        back = allocator_.create(*first);
+        *tail = back;
+        tail = &back->right_;
+        ++size_;
     }
+
+    Node *list = root_;
+    root_ = build(list, size_);
 }
 
-template <typename T>
-void structures::AVLTree<T>::insert(const T& data) {
-    if (empty()) {
-        root_ = new Node(data);
-    } else if (!contains(data)) {
-        if (data < root_->data_) {
-            if (root_->left_ == nullptr)
-                root_->left_ = new Node(data);
-            else
-                root_->left_->insert(data);
-        } else {
-            if (root_->right_ == nullptr)
-                root_->right_ = new Node(data);
-            else
-                root_->right_->insert(data);
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::merge(const AVLTree& other) {
+    if (&other == this)
+        return;
+
+    /// *tail e' sempre o restante desta arvore: a lista guarda todos os nodos,
+    /// e se a copia de um dado lancar excecao a arvore e' remontada com eles
+    Node *list = flatten(root_);
+    root_ = nullptr;
+    Node **tail = &list;
+    try {
+        for (const T& data : other) {
+            while ((*tail != nullptr) && ((*tail)->data_ < data))
+                tail = &(*tail)->right_;
+            if ((*tail != nullptr) && !(data < (*tail)->data_)) {
+                tail = &(*tail)->right_;
+                continue;
+            }
+
+            Node *node = allocator_.create(data);
+            node->right_ = *tail;
+            *tail = node;
+            tail = &node->right_;
+            ++size_;
         }
+    } catch (...) {
+        root_ = build(list, size_);
+        throw;
+    }
+
+    root_ = build(list, size_);
+}
 
-        root_->updateHeight();
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::merge(AVLTree&& other) {
+    if (&other != this)
+        apply(&unite_nodes, other);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::intersect(AVLTree&& other) {
+    if (&other != this)
+        apply(&intersect_nodes, other);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::subtract(AVLTree&& other) {
+    if (&other == this)
+        clear();
+    else
+        apply(&subtract_nodes, other);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+bool structures::AVLTree<T, Allocator, Ranked>::split(const T& data,
+                                                      AVLTree& less,
+                                                      AVLTree& greater) {
+    if (&less == &greater)
+        throw std::invalid_argument("Aliased trees");
+
+    Node *root = root_;
+    std::size_t total = size_;
+    root_ = nullptr;
+    size_ = 0;
+
+    less.clear();
+    greater.clear();
+    less.allocator_ = allocator_;
+    greater.allocator_ = allocator_;
+    Node *found = split_nodes(root, data, less.root_, greater.root_);
+    if (found != nullptr) {
+        less.allocator_.destroy(found);
+        --total;
+    }
+
+    count_parts(less, greater, total, std::integral_constant<bool, Ranked>());
+    return found != nullptr;
+}
 
-        int fb = root_->fb();
-        int sqrd_fb = fb * fb;
-        if (sqrd_fb > 1) {  // No' desbalanceado
-            if (fb > 0) {
-                if (root_->left_->fb() > 0)
-                    root_ = root_->simpleRight();
-                else
-                    root_ = root_->doubleRight();
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::join(const T& data,
+                                                     AVLTree&& greater) {
+    if ((!empty() && !(max() < data)) ||
+        (!greater.empty() && !(data < greater.min())))
+        throw std::invalid_argument("Unordered join");
+
+    AVLTree right = adopt(greater);
+    Node *middle = allocator_.create(data);
+    root_ = join_nodes(root_, middle, right.root_);
+    size_ += right.size_ + 1;
+    right.root_ = nullptr;
+    right.size_ = 0;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::clear() {
+    /// Na arena, a memoria de todos os nodos e' liberada junto com o alocador
+    if (!(Allocator<Node>::bulk_release &&
+          std::is_trivially_destructible<T>::value)) {
+        /// Desmontagem iterativa em O(n) e sem pilha: enquanto o no' corrente
+        /// tem filho esquerdo, rotaciona a direita; senao, libera-o e segue a
+        /// direita
+        Node *node = root_;
+        while (node != nullptr) {
+            if (node->left_ != nullptr) {
+                Node *left = node->left_;
+                node->left_ = left->right_;
+                left->right_ = node;
+                node = left;
             } else {
-                if (root_->right_->fb() > 0)
-                    root_ = root_->simpleLeft();
-                else
-                    root_ = root_->doubleLeft();
+                Node *right = node->right_;
+                allocator_.destroy(node);
+                node = right;
             }
         }
     }
 
-    size_++;
+    root_ = nullptr;
+    size_ = 0;
 }
 
-template <typename T>
-void structures::AVLTree<T>::remove(const T& data) {
-    if ((data > root_->data_) && (root_->right_ != nullptr)) {
-        if (!root_->right_->remove(data)) {
-            delete root_->right_;
-            root_->right_ = nullptr;
-        }
-    } else if ((data < root_->data_) && (root_->left_ != nullptr)) {
-        if (!root_->left_->remove(data)) {
-            delete root_->left_;
-            root_->left_ = nullptr;
-        }
-    } else {
-        if ((root_->right_ != nullptr) && (root_->left_ != nullptr)) {
-            root_->data_ = root_->right_->minimun();
-            root_->right_->remove(root_->data_);
-        } else if (root_->right_ != nullptr) {
-            root_->data_ = root_->right_->data_;
-            root_->right_->remove(root_->data_);
-        } else if (root_->left_ != nullptr) {
-            root_->data_ = root_->left_->data_;
-            root_->left_->remove(root_->data_);
-        } else {
-            delete root_;
-            root_ = nullptr;
-        }
+template <typename T, template<typename> class Allocator, bool Ranked>
+structures::FrozenTree<T> structures::AVLTree<T, Allocator, Ranked>::freeze() const {
+    return FrozenTree<T>{begin(), end()};
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+bool structures::AVLTree<T, Allocator, Ranked>::insert(const T& data) {
+    Path path;
+    Node **link = descend(data, path);
+    if (*link != nullptr)
+        return false;
+
+    link_new(link, path, data);
+    return true;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+template<typename... Args>
+std::pair<typename structures::AVLTree<T, Allocator, Ranked>::iterator, bool>
+structures::AVLTree<T, Allocator, Ranked>::try_emplace(Args&&... args) {
+    T data(std::forward<Args>(args)...);
+    Path path;
+    Node **link = descend(data, path);
+    if (*link != nullptr)
+        return std::make_pair(find(data), false);
+
+    /// As rotacoes mudam o caminho: o iterador refaz a descida
+    Node *node = link_new(link, path, std::move(data));
+    return std::make_pair(find(node->data_), true);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+std::pair<typename structures::AVLTree<T, Allocator, Ranked>::iterator, bool>
+structures::AVLTree<T, Allocator, Ranked>::insert_or_assign(const T& data) {
+    Path path;
+    Node **link = descend(data, path);
+    bool inserted = (*link == nullptr);
+    if (inserted)
+        link_new(link, path, data);
+    else
+        (*link)->data_ = data;
+
+    return std::make_pair(find(data), inserted);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::iterator
+structures::AVLTree<T, Allocator, Ranked>::find(const T& data) const {
+    iterator it{this};
+    const Node *node = root_;
+    while (node != nullptr) {
+        it.path_[it.depth_++] = node;
+        if (data < node->data_)
+            node = node->left_;
+        else if (node->data_ < data)
+            node = node->right_;
+        else
+            return it;
     }
 
+    return end();
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::iterator
+structures::AVLTree<T, Allocator, Ranked>::lower_bound(const T& data) const {
+    return first_after(data, false);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::iterator
+structures::AVLTree<T, Allocator, Ranked>::upper_bound(const T& data) const {
+    return first_after(data, true);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::iterator
+structures::AVLTree<T, Allocator, Ranked>::floor(const T& data) const {
+    return last_before(data, true);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::iterator
+structures::AVLTree<T, Allocator, Ranked>::ceiling(const T& data) const {
+    return first_after(data, false);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+const T& structures::AVLTree<T, Allocator, Ranked>::min() const {
+    if (empty())
+        throw std::out_of_range("Empty tree");
+
+    return root_->minimun();
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+const T& structures::AVLTree<T, Allocator, Ranked>::max() const {
+    if (empty())
+        throw std::out_of_range("Empty tree");
+
+    return root_->maximun();
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Range
+structures::AVLTree<T, Allocator, Ranked>::range(const T& lo, const T& hi) const {
+    if (hi < lo)
+        return Range{end(), end()};
+
+    return Range{first_after(lo, false), first_after(hi, true)};
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::iterator
+structures::AVLTree<T, Allocator, Ranked>::begin() const {
+    iterator it{this};
     if (root_ != nullptr) {
-        root_->updateHeight();
-
-        int fb_node = root_->fb();
-        int sqrd_fb = fb_node * fb_node;
-        while (sqrd_fb > 1) {  // Raiz desbalanceada
-            if (fb_node > 0) {
-                if (root_->left_->fb() > 0)
-                    root_->left_ = root_->simpleRight();
-                else
-                    root_->left_ = root_->doubleRight();
-            } else {
-                if (root_->right_->fb() > 0)
-                    root_->right_ = root_->simpleLeft();
-                else
-                    root_->right_ = root_->doubleLeft();
-            }
+        it.path_[it.depth_++] = root_;
+        it.leftmost();
+    }
 
-            root_->updateHeight();
-            fb_node = root_->fb();
-            sqrd_fb = fb_node * fb_node;
+    return it;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::iterator
+structures::AVLTree<T, Allocator, Ranked>::end() const {
+    return iterator{this};
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::remove(const T& data) {
+    Path path;
+    Node **link = descend(data, path);
+    Node *node = *link;
+    if (node == nullptr)
+        return;
+
+    if ((node->left_ != nullptr) && (node->right_ != nullptr)) {
+        /// Troca o no' pelo sucessor (menor da subarvore direita), religando
+        /// os nodos em vez de copiar o dado
+        std::size_t position = path.depth;
+        path.push(link);
+        Node **successor_link = &node->right_;
+        while ((*successor_link)->left_ != nullptr) {
+            path.push(successor_link);
+            successor_link = &(*successor_link)->left_;
         }
+
+        Node *successor = *successor_link;
+        *successor_link = successor->right_;
+        successor->left_ = node->left_;
+        successor->right_ = node->right_;
+        successor->height_ = node->height_;
+        *link = successor;
+        if (path.depth > position + 1)
+            path.links[position + 1] = &successor->right_;
+    } else {
+        *link = (node->left_ != nullptr) ? node->left_ : node->right_;
     }
 
+    allocator_.destroy(node);
     size_--;
+    rebalance_path(path);
 }
 
-template <typename T>
-bool structures::AVLTree<T>::contains(const T& data) const {
-    if (root_->data_ == data) {
-        return true;
-    } else {
-        if ((data <= root_->data_) && (root_->left_ != nullptr))
-            return root_->left_->contains(data);
-        else if (root_->right_ != nullptr)
-            return root_->right_->contains(data);
+template <typename T, template<typename> class Allocator, bool Ranked>
+bool structures::AVLTree<T, Allocator, Ranked>::contains(const T& data) const {
+    const Node *node = root_;
+    while (node != nullptr) {
+        if (data < node->data_)
+            node = node->left_;
+        else if (node->data_ < data)
+            node = node->right_;
         else
-            return false;
+            return true;
     }
+
+    return false;
 }
 
-template <typename T>
-bool structures::AVLTree<T>::empty() const {
+template <typename T, template<typename> class Allocator, bool Ranked>
+bool structures::AVLTree<T, Allocator, Ranked>::empty() const {
     return size_ == 0;
 }
 
-template <typename T>
-std::size_t structures::AVLTree<T>::size() const {
+template <typename T, template<typename> class Allocator, bool Ranked>
+std::size_t structures::AVLTree<T, Allocator, Ranked>::size() const {
     return size_;
 }
 
-template <typename T>
-structures::ArrayList<T> structures::AVLTree<T>::pre_order() const {
-    ArrayList<T> list{size_};
+template <typename T, template<typename> class Allocator, bool Ranked>
+template<typename Visitor>
+void structures::AVLTree<T, Allocator, Ranked>::visit_pre_order(
+    Visitor&& visit) const {
+    /// Pilha das subarvores direitas pendentes: no maximo uma por nivel
+    const Node *pending[AVL_MAX_HEIGHT];
+    std::size_t depth = 0;
+    const Node *node = root_;
+    while ((node != nullptr) || (depth > 0)) {
+        if (node == nullptr)
+            node = pending[--depth];
 
-    list.push_back(root_->data_);
-    if (root_->left_ != nullptr)
-        root_->left_->pre_order(list);
-    if (root_->right_ != nullptr)
-        root_->right_->pre_order(list);
+        visit(node->data_);
+        if (node->right_ != nullptr)
+            pending[depth++] = node->right_;
+        node = node->left_;
+    }
+}
 
-    return list;
+template <typename T, template<typename> class Allocator, bool Ranked>
+template<typename Visitor>
+void structures::AVLTree<T, Allocator, Ranked>::visit_in_order(
+    Visitor&& visit) const {
+    for (const_iterator it = begin(); it != end(); ++it)
+        visit(*it);
 }
 
-template <typename T>
-structures::ArrayList<T> structures::AVLTree<T>::in_order() const {
-    ArrayList<T> list{size_};
+template <typename T, template<typename> class Allocator, bool Ranked>
+template<typename Visitor>
+void structures::AVLTree<T, Allocator, Ranked>::visit_post_order(
+    Visitor&& visit) const {
+    /// Pilha com o caminho ate o no' corrente
+    const Node *path[AVL_MAX_HEIGHT];
+    std::size_t depth = 0;
+    const Node *node = root_;
+    const Node *last = nullptr;  // ultimo no' visitado
+    while ((node != nullptr) || (depth > 0)) {
+        if (node != nullptr) {
+            path[depth++] = node;
+            node = node->left_;
+        } else {
+            const Node *top = path[depth - 1];
+            if ((top->right_ != nullptr) && (top->right_ != last)) {
+                node = top->right_;
+            } else {
+                visit(top->data_);
+                last = top;
+                depth--;
+            }
+        }
+    }
+}
 
-    if (root_->left_ != nullptr)
-        root_->left_->in_order(list);
-    list.push_back(root_->data_);
-    if (root_->right_ != nullptr)
-        root_->right_->in_order(list);
+template <typename T, template<typename> class Allocator, bool Ranked>
+structures::ArrayList<T> structures::AVLTree<T, Allocator, Ranked>::pre_order() const {
+    ArrayList<T> list{size_};
+    visit_pre_order([&list](const T& data) { list.push_back(data); });
+    return list;
+}
 
+template <typename T, template<typename> class Allocator, bool Ranked>
+structures::ArrayList<T> structures::AVLTree<T, Allocator, Ranked>::in_order() const {
+    ArrayList<T> list{size_};
+    visit_in_order([&list](const T& data) { list.push_back(data); });
     return list;
 }
 
-template <typename T>
-structures::ArrayList<T> structures::AVLTree<T>::post_order() const {
+template <typename T, template<typename> class Allocator, bool Ranked>
+structures::ArrayList<T> structures::AVLTree<T, Allocator, Ranked>::post_order() const {
     ArrayList<T> list{size_};
+    visit_post_order([&list](const T& data) { list.push_back(data); });
+    return list;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node**
+structures::AVLTree<T, Allocator, Ranked>::descend(const T& data, Path& path) {
+    Node **link = &root_;
+    while (*link != nullptr) {
+        if (data < (*link)->data_) {
+            path.push(link);
+            link = &(*link)->left_;
+        } else if ((*link)->data_ < data) {
+            path.push(link);
+            link = &(*link)->right_;
+        } else {
+            break;
+        }
+    }
+
+    return link;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+template<typename U>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::link_new(Node** link, Path& path,
+                                            U&& data) {
+    Node *node = allocator_.create(std::forward<U>(data));
+    *link = node;
+    size_++;
+    rebalance_path(path);
+    return node;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+int structures::AVLTree<T, Allocator, Ranked>::height(const Node* node) {
+    return (node == nullptr) ? 0 : node->height_;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::update_height(Node* node) {
+    node->height_ = 1 + std::max(height(node->left_), height(node->right_));
+    update_count(node, std::integral_constant<bool, Ranked>());
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+std::size_t structures::AVLTree<T, Allocator, Ranked>::count(const Node* node) {
+    return (node == nullptr) ? 0 : node->count_;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::update_count(Node* node,
+                                                            std::true_type) {
+    node->count_ = 1 + count(node->left_) + count(node->right_);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::update_count(Node*,
+                                                            std::false_type) {}
 
-    if (root_->left_ != nullptr)
-        root_->left_->post_order(list);
-    if (root_->right_ != nullptr)
-        root_->right_->post_order(list);
-    list.push_back(root_->data_);
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::flatten(Node* root) {
+    Node *list = nullptr;
+    Node **tail = &list;
+    Node *node = root;
+    while (node != nullptr) {
+        if (node->left_ != nullptr) {
+            Node *left = node->left_;
+            node->left_ = left->right_;
+            left->right_ = node;
+            node = left;
+        } else {
+            *tail = node;
+            tail = &node->right_;
+            node = node->right_;
+        }
+    }
 
     return list;
 }
 
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::build(Node*& list, std::size_t n) {
+    /// Recursao de profundidade log2(n): metades de tamanhos diferindo de no
+    /// maximo 1 dao uma arvore AVL valida
+    if (n == 0)
+        return nullptr;
+
+    Node *left = build(list, n / 2);
+    Node *node = list;
+    list = list->right_;
+    node->left_ = left;
+    node->right_ = build(list, n - n / 2 - 1);
+    update_height(node);
+    return node;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+structures::AVLTree<T, Allocator, Ranked>
+structures::AVLTree<T, Allocator, Ranked>::adopt(AVLTree& other) {
+    AVLTree adopted;
+    adopted.allocator_ = allocator_;
+    if (allocator_ != other.allocator_) {
+        /// Nodos de outro pool nao podem ser liberados por este alocador:
+        /// copia os dados, em O(n)
+        adopted.build_sorted(other.begin(), other.end());
+        other.clear();
+    } else {
+        std::swap(adopted.root_, other.root_);
+        std::swap(adopted.size_, other.size_);
+    }
+
+    return adopted;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::apply(SetOperation operation,
+                                                      AVLTree& other) {
+    AVLTree adopted = adopt(other);
+    Garbage garbage;
+    root_ = operation(root_, adopted.root_, garbage, spawn_depth());
+
+    /// Cada no' descartado sai da soma dos tamanhos (na uniao, os repetidos;
+    /// na interseccao, um de cada par repetido e os nao repetidos; na
+    /// diferenca, os repetidos e todos os de other)
+    size_ = size_ + adopted.size_ - garbage.size;
+    adopted.root_ = nullptr;
+    adopted.size_ = 0;
+    release(garbage);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::release(Garbage& garbage) {
+    Node *node = garbage.head;
+    while (node != nullptr) {
+        Node *next = node->right_;
+        allocator_.destroy(node);
+        node = next;
+    }
+
+    garbage.head = nullptr;
+    garbage.tail = &garbage.head;
+    garbage.size = 0;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+unsigned structures::AVLTree<T, Allocator, Ranked>::spawn_depth() {
+    unsigned depth = 0;
+    while ((1u << depth) < std::thread::hardware_concurrency())
+        ++depth;
+    return depth;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::join_nodes(Node* left, Node* middle,
+                                                      Node* right) {
+    if (height(left) > height(right) + 1)
+        return join_right(left, middle, right);
+    if (height(right) > height(left) + 1)
+        return join_left(left, middle, right);
+
+    middle->left_ = left;
+    middle->right_ = right;
+    update_height(middle);
+    return middle;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::join_right(Node* left, Node* middle,
+                                                      Node* right) {
+    /// Desce pela direita de left ate uma subarvore da altura de right, e
+    /// rebalanceia na volta como numa insercao
+    if (height(left->right_) <= height(right) + 1) {
+        middle->left_ = left->right_;
+        middle->right_ = right;
+        update_height(middle);
+        left->right_ = middle;
+    } else {
+        left->right_ = join_right(left->right_, middle, right);
+    }
+
+    rebalance(&left);
+    return left;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::join_left(Node* left, Node* middle,
+                                                     Node* right) {
+    if (height(right->left_) <= height(left) + 1) {
+        middle->left_ = left;
+        middle->right_ = right->left_;
+        update_height(middle);
+        right->left_ = middle;
+    } else {
+        right->left_ = join_left(left, middle, right->left_);
+    }
+
+    rebalance(&right);
+    return right;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::join_pair(Node* left, Node* right) {
+    if (left == nullptr)
+        return right;
+    if (right == nullptr)
+        return left;
+
+    Node *last;
+    Node *rest = split_last(left, last);
+    return join_nodes(rest, last, right);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::split_last(Node* root, Node*& last) {
+    if (root->right_ == nullptr) {
+        last = root;
+        return root->left_;
+    }
+
+    Node *rest = split_last(root->right_, last);
+    return join_nodes(root->left_, root, rest);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::split_nodes(Node* root,
+                                                       const T& data,
+                                                       Node*& less,
+                                                       Node*& greater) {
+    if (root == nullptr) {
+        less = greater = nullptr;
+        return nullptr;
+    }
+
+    Node *found;
+    if (data < root->data_) {
+        found = split_nodes(root->left_, data, less, greater);
+        greater = join_nodes(greater, root, root->right_);
+    } else if (root->data_ < data) {
+        found = split_nodes(root->right_, data, less, greater);
+        less = join_nodes(root->left_, root, less);
+    } else {
+        found = root;
+        less = root->left_;
+        greater = root->right_;
+        root->left_ = root->right_ = nullptr;
+    }
+
+    return found;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::count_parts(
+    AVLTree& less, AVLTree& greater, std::size_t total, std::true_type) {
+    less.size_ = count(less.root_);
+    greater.size_ = total - less.size_;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::count_parts(
+    AVLTree& less, AVLTree& greater, std::size_t total, std::false_type) {
+    /// Percorre as duas partes juntas ate a menor acabar
+    iterator a = less.begin(), a_end = less.end();
+    iterator b = greater.begin(), b_end = greater.end();
+    std::size_t smaller = 0;
+    while ((a != a_end) && (b != b_end)) {
+        ++a;
+        ++b;
+        ++smaller;
+    }
+
+    less.size_ = (a == a_end) ? smaller : total - smaller;
+    greater.size_ = total - less.size_;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::halves(
+    SetOperation operation, Node* a_left, Node* b_left, Node*& left,
+    Node* a_right, Node* b_right, Node*& right, Garbage& garbage,
+    unsigned spawn) {
+    bool parallel = (spawn > 0) &&
+                    (std::min({height(a_left), height(b_left), height(a_right),
+                               height(b_right)}) >= AVL_PARALLEL_HEIGHT);
+    if (!parallel) {
+        left = operation(a_left, b_left, garbage, spawn);
+        right = operation(a_right, b_right, garbage, spawn);
+        return;
+    }
+
+    /// As metades sao subarvores disjuntas; cada tarefa descarta numa lista
+    /// propria. Se nao houver thread disponivel, a tarefa roda no get()
+    Garbage left_garbage;
+    std::future<Node*> task = std::async(
+        std::launch::async | std::launch::deferred, operation, a_left, b_left,
+        std::ref(left_garbage), spawn - 1);
+    right = operation(a_right, b_right, garbage, spawn - 1);
+    left = task.get();
+    garbage.append(left_garbage);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::unite_nodes(Node* a, Node* b,
+                                                       Garbage& garbage,
+                                                       unsigned spawn) {
+    if (a == nullptr)
+        return b;
+    if (b == nullptr)
+        return a;
+
+    Node *less, *greater;
+    Node *repeated = split_nodes(b, a->data_, less, greater);
+    if (repeated != nullptr)
+        garbage.push(repeated);
+
+    Node *left, *right;
+    halves(&unite_nodes, a->left_, less, left, a->right_, greater, right,
+           garbage, spawn);
+    return join_nodes(left, a, right);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::intersect_nodes(Node* a, Node* b,
+                                                           Garbage& garbage,
+                                                           unsigned spawn) {
+    if ((a == nullptr) || (b == nullptr)) {
+        garbage.push_tree(a);
+        garbage.push_tree(b);
+        return nullptr;
+    }
+
+    Node *less, *greater;
+    Node *repeated = split_nodes(b, a->data_, less, greater);
+
+    Node *left, *right;
+    halves(&intersect_nodes, a->left_, less, left, a->right_, greater, right,
+           garbage, spawn);
+    if (repeated != nullptr) {
+        garbage.push(repeated);
+        return join_nodes(left, a, right);
+    }
+
+    garbage.push(a);
+    return join_pair(left, right);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::subtract_nodes(Node* a, Node* b,
+                                                          Garbage& garbage,
+                                                          unsigned spawn) {
+    if ((a == nullptr) || (b == nullptr)) {
+        garbage.push_tree(b);
+        return a;
+    }
+
+    Node *less, *greater;
+    Node *repeated = split_nodes(a, b->data_, less, greater);
+    if (repeated != nullptr)
+        garbage.push(repeated);
+
+    Node *left, *right;
+    halves(&subtract_nodes, less, b->left_, left, greater, b->right_, right,
+           garbage, spawn);
+    garbage.push(b);
+    return join_pair(left, right);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::rotate_left(Node* node) {
+    Node *right = node->right_;
+    node->right_ = right->left_;
+    right->left_ = node;
+    update_height(node);
+    update_height(right);
+    return right;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::Node*
+structures::AVLTree<T, Allocator, Ranked>::rotate_right(Node* node) {
+    Node *left = node->left_;
+    node->left_ = left->right_;
+    left->right_ = node;
+    update_height(node);
+    update_height(left);
+    return left;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+bool structures::AVLTree<T, Allocator, Ranked>::rebalance(Node** link) {
+    Node *node = *link;
+    int old_height = node->height_;
+    int balance = height(node->left_) - height(node->right_);
+
+    if (balance > 1) {  // pesada a esquerda
+        if (height(node->left_->left_) < height(node->left_->right_))
+            node->left_ = rotate_left(node->left_);  // rotacao dupla
+        node = rotate_right(node);
+    } else if (balance < -1) {  // pesada a direita
+        if (height(node->right_->right_) < height(node->right_->left_))
+            node->right_ = rotate_right(node->right_);  // rotacao dupla
+        node = rotate_left(node);
+    } else {
+        update_height(node);
+    }
+
+    *link = node;
+    return node->height_ != old_height;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+void structures::AVLTree<T, Allocator, Ranked>::rebalance_path(Path& path) {
+    while (path.depth > 0) {
+        if (!rebalance(path.links[--path.depth]))
+            break;
+    }
+
+    /// A altura parou de mudar, mas os tamanhos acima ainda mudam
+    while (Ranked && (path.depth > 0))
+        update_count(*path.links[--path.depth],
+                     std::integral_constant<bool, Ranked>());
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+std::size_t structures::AVLTree<T, Allocator, Ranked>::rank(const T& data) const {
+    return count_below(data, false);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+const T& structures::AVLTree<T, Allocator, Ranked>::select(std::size_t k) const {
+    static_assert(Ranked, "select requires a ranked tree");
+    if (k >= size_)
+        throw std::out_of_range("Invalid index");
+
+    const Node *node = root_;
+    while (true) {
+        std::size_t left = count(node->left_);
+        if (k < left) {
+            node = node->left_;
+        } else if (k > left) {
+            k -= left + 1;
+            node = node->right_;
+        } else {
+            return node->data_;
+        }
+    }
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+std::size_t structures::AVLTree<T, Allocator, Ranked>::count_range(
+    const T& lo, const T& hi) const {
+    if (hi < lo)
+        return 0;
+
+    return count_below(hi, true) - count_below(lo, false);
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+std::size_t structures::AVLTree<T, Allocator, Ranked>::count_below(
+    const T& data, bool inclusive) const {
+    static_assert(Ranked, "rank queries require a ranked tree");
+    std::size_t below = 0;
+    const Node *node = root_;
+    while (node != nullptr) {
+        if ((data < node->data_) || (!inclusive && !(node->data_ < data))) {
+            node = node->left_;
+        } else {
+            below += count(node->left_) + 1;
+            node = node->right_;
+        }
+    }
+
+    return below;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::iterator
+structures::AVLTree<T, Allocator, Ranked>::first_after(
+    const T& data, bool inclusive) const {
+    /// O caminho ate o ultimo no' onde a descida foi a esquerda e' um
+    /// prefixo do caminho percorrido: basta trunca-lo
+    iterator it{this};
+    std::size_t found = 0;
+    const Node *node = root_;
+    while (node != nullptr) {
+        it.path_[it.depth_++] = node;
+        if ((data < node->data_) || (!inclusive && !(node->data_ < data))) {
+            found = it.depth_;
+            node = node->left_;
+        } else {
+            node = node->right_;
+        }
+    }
+
+    it.depth_ = found;
+    return it;
+}
+
+template <typename T, template<typename> class Allocator, bool Ranked>
+typename structures::AVLTree<T, Allocator, Ranked>::iterator
+structures::AVLTree<T, Allocator, Ranked>::last_before(
+    const T& data, bool inclusive) const {
+    iterator it{this};
+    std::size_t found = 0;
+    const Node *node = root_;
+    while (node != nullptr) {
+        it.path_[it.depth_++] = node;
+        if ((data < node->data_) || (!inclusive && !(node->data_ < data))) {
+            node = node->left_;
+        } else {
+            found = it.depth_;
+            node = node->right_;
+        }
+    }
+
+    it.depth_ = found;
+    return it;
+}
+
 #endif
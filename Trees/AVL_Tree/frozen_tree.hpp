@@ -0,0 +1,216 @@
+/// Copyright [2018] <João Fellipe Uller>
+#ifndef STRUCTURES_FROZEN_TREE_H
+#define STRUCTURES_FROZEN_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>  // placement new
+#include <utility>
+
+#define FROZEN_CACHE_LINE 64u
+
+#if defined(__GNUC__)
+#define FROZEN_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define FROZEN_PREFETCH(address) ((void) (address))
+#endif
+
+namespace structures {
+
+template<typename T>
+/// Copia imutavel e contigua de uma arvore de busca, no layout de Eytzinger
+///
+/// Os dados ficam num vetor em ordem de busca em largura: os filhos do
+/// indice k sao 2k e 2k + 1, sem ponteiros. Uma busca desce sem desvios
+/// condicionais e, a cada passo, pede ao processador a linha de cache dos
+/// descendentes alguns niveis abaixo, que ficam lado a lado no vetor
+class FrozenTree {
+ public:
+    /// Construtor a partir de dados em ordem crescente e sem repeticoes,
+    /// em O(n)
+    template<typename ForwardIt>
+    FrozenTree(ForwardIt first, ForwardIt last);
+
+    /// Construtor de movimento
+    FrozenTree(FrozenTree&& other);
+
+    /// A copia e' imutavel: nao ha por que duplica-la
+    FrozenTree(const FrozenTree&) = delete;
+    FrozenTree& operator=(const FrozenTree&) = delete;
+
+    /// Destrutor
+    ~FrozenTree();
+
+    /// Retorna se um dado existe na copia
+    bool contains(const T& data) const;
+
+    /// Primeiro dado nao menor que data, ou nulo se nao ha
+    const T* lower_bound(const T& data) const;
+
+    /// Retorna se a copia esta vazia
+    bool empty() const;
+
+    /// Retorna o numero de elementos da copia
+    std::size_t size() const;
+
+ private:
+    /// Descendentes de k que cabem numa linha de cache: os de 2^d * k ate
+    /// 2^d * k + 2^d - 1, para a maior potencia 2^d que cabe
+    static constexpr std::size_t stride(std::size_t per_line,
+                                        std::size_t step = 1u) {
+        return (step * 2 <= per_line) ? stride(per_line, step * 2) : step;
+    }
+
+    static constexpr std::size_t prefetch_stride() {
+        return stride(FROZEN_CACHE_LINE / sizeof(T));
+    }
+
+    /// Primeiro indice em ordem (o mais a esquerda)
+    std::size_t first_index() const;
+
+    /// Indice seguinte em ordem; 0 depois do ultimo
+    std::size_t next_index(std::size_t k) const;
+
+    /// Indice do primeiro dado nao menor que data; 0 se nao ha
+    std::size_t lower_index(const T& data) const;
+
+    /// Destroi os count primeiros dados em ordem e libera o vetor
+    void destroy(std::size_t count);
+
+    void* memory_{nullptr};  // bloco alocado
+    T* contents_{nullptr};  // alinhado a linha de cache; indices a partir de 1
+    std::size_t size_{0u};
+};
+
+}  // namespace structures
+
+/// IMPLEMENTACAO DOS METODOS DE FROZEN_TREE
+
+template<typename T>
+template<typename ForwardIt>
+structures::FrozenTree<T>::FrozenTree(ForwardIt first, ForwardIt last):
+    size_{static_cast<std::size_t>(std::distance(first, last))}
+{
+    if (size_ == 0)
+        return;
+
+    /// Alinha o indice 0 a linha de cache, para que os descendentes
+    /// consecutivos de um no' caiam na mesma linha
+    memory_ = ::operator new((size_ + 1) * sizeof(T) + FROZEN_CACHE_LINE);
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory_);
+    std::uintptr_t mask = FROZEN_CACHE_LINE - 1;
+    address = (address + mask) & ~mask;
+    contents_ = reinterpret_cast<T*>(address);
+
+    /// Percorre os indices em ordem, consumindo os dados em ordem crescente
+    std::size_t built = 0;
+    try {
+        for (std::size_t k = first_index(); k != 0; k = next_index(k)) {
+            new (&contents_[k]) T(*first);
+            ++first;
+            ++built;
+        }
+    } catch (...) {
+        destroy(built);
+        throw;
+    }
+}
+
+template<typename T>
+structures::FrozenTree<T>::FrozenTree(FrozenTree&& other):
+    memory_{other.memory_},
+    contents_{other.contents_},
+    size_{other.size_}
+{
+    other.memory_ = nullptr;
+    other.contents_ = nullptr;
+    other.size_ = 0;
+}
+
+template<typename T>
+structures::FrozenTree<T>::~FrozenTree() {
+    destroy(size_);
+}
+
+template<typename T>
+bool structures::FrozenTree<T>::contains(const T& data) const {
+    std::size_t k = lower_index(data);
+    return (k != 0) && !(data < contents_[k]);
+}
+
+template<typename T>
+const T* structures::FrozenTree<T>::lower_bound(const T& data) const {
+    std::size_t k = lower_index(data);
+    return (k == 0) ? nullptr : &contents_[k];
+}
+
+template<typename T>
+bool structures::FrozenTree<T>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T>
+std::size_t structures::FrozenTree<T>::size() const {
+    return size_;
+}
+
+template<typename T>
+std::size_t structures::FrozenTree<T>::first_index() const {
+    std::size_t k = (size_ == 0) ? 0 : 1;
+    while ((k != 0) && (2 * k <= size_))
+        k = 2 * k;
+    return k;
+}
+
+template<typename T>
+std::size_t structures::FrozenTree<T>::next_index(std::size_t k) const {
+    if (2 * k + 1 <= size_) {  // menor da subarvore direita
+        k = 2 * k + 1;
+        while (2 * k <= size_)
+            k = 2 * k;
+        return k;
+    }
+
+    /// Sobe enquanto vem de um filho direito; depois, uma vez mais
+    while (k & 1u)
+        k >>= 1;
+    return k >> 1;
+}
+
+template<typename T>
+std::size_t structures::FrozenTree<T>::lower_index(const T& data) const {
+    /// Desce sem desvios: a direita se o dado do no' e' menor que data. Ao
+    /// fim, k codifica o caminho em bits; o resultado e' o ultimo no' onde
+    /// a descida foi a esquerda, isto e', k sem os bits 1 finais e mais um
+    std::size_t k = 1;
+    while (k <= size_) {
+        std::size_t ahead = k * prefetch_stride();
+        if (ahead <= size_)
+            FROZEN_PREFETCH(&contents_[ahead]);
+        k = 2 * k + static_cast<std::size_t>(contents_[k] < data);
+    }
+
+#if defined(__GNUC__)
+    return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+#else
+    while (k & 1u)
+        k >>= 1;
+    return k >> 1;
+#endif
+}
+
+template<typename T>
+void structures::FrozenTree<T>::destroy(std::size_t count) {
+    std::size_t k = first_index();
+    for (std::size_t i = 0; i < count; ++i) {
+        contents_[k].~T();
+        k = next_index(k);
+    }
+
+    ::operator delete(memory_);
+    memory_ = nullptr;
+    contents_ = nullptr;
+}
+
+#endif
@@ -1,6 +1,10 @@
 // Copyright 2016 João Paulo Taylor Ienczak Zanette
 // Jean Everson Martina
 
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -278,7 +282,7 @@ TEST_F(AVLTreeTest, PreOrder) {
         multiple_insertion(int_list, int_values);
 
         auto preordered = int_list.pre_order();
-        auto expected = {10, 5, -5, -10, -15, 8, 20, 15, 25, 30};
+        auto expected = {10, 5, -10, -15, -5, 8, 20, 15, 25, 30};
         auto i = 0u;
         for (auto& value : expected) {
             ASSERT_EQ(value, preordered[i]);
@@ -291,7 +295,7 @@ TEST_F(AVLTreeTest, PreOrder) {
 
         auto preordered = string_list.pre_order();
         auto expected = {
-            "AAA", "123", "BBB", "Hello, World!", "Goodbye, World!"
+            "AAA", "123", "Goodbye, World!", "BBB", "Hello, World!"
         };
         auto i = 0u;
         for (auto& value : expected) {
@@ -304,7 +308,7 @@ TEST_F(AVLTreeTest, PreOrder) {
         multiple_insertion(dummy_list, dummy_values);
         auto preordered = dummy_list.pre_order();
 
-        auto expected = {0., -5., -5.5, -10., 10., 7.5, 3.1415, 4.2};
+        auto expected = {0., -5.5, -10., -5., 7.5, 3.1415, 4.2, 10.};
         auto i = 0u;
         for (auto& value : expected) {
             ASSERT_EQ(Dummy{value}, preordered[i]);
@@ -364,7 +368,7 @@ TEST_F(AVLTreeTest, PostOrder) {
         multiple_insertion(int_list, int_values);
 
         auto postordered = int_list.post_order();
-        auto expected = {-15, -10, -5, 8, 5, 15, 30, 25, 20, 10};
+        auto expected = {-15, -5, -10, 8, 5, 15, 30, 25, 20, 10};
         auto i = 0u;
         for (auto& value : expected) {
             ASSERT_EQ(value, postordered[i]);
@@ -377,7 +381,7 @@ TEST_F(AVLTreeTest, PostOrder) {
 
         auto postordered = string_list.post_order();
         auto expected = {
-            "123", "Goodbye, World!", "Hello, World!", "BBB", "AAA"
+            "123", "BBB", "Hello, World!", "Goodbye, World!", "AAA"
         };
         auto i = 0u;
         for (auto& value : expected) {
@@ -390,7 +394,7 @@ TEST_F(AVLTreeTest, PostOrder) {
         multiple_insertion(dummy_list, dummy_values);
         auto postordered = dummy_list.post_order();
 
-        auto expected = {-10., -5.5, -5., 4.2, 3.1415, 7.5, 10., 0.};
+        auto expected = {-10., -5., -5.5, 4.2, 3.1415, 10., 7.5, 0.};
         auto i = 0u;
         for (auto& value : expected) {
             ASSERT_EQ(Dummy{value}, postordered[i]);
@@ -400,6 +404,610 @@ TEST_F(AVLTreeTest, PostOrder) {
 }
 
 
+/**
+ * Testa a árvore com nodos alocados em pool.
+ */
+TEST_F(AVLTreeTest, PoolAllocator) {
+    structures::AVLTree<int, structures::PoolAllocator> pooled{};
+    multiple_insertion(pooled, int_values);
+    contains_all(pooled, int_values);
+
+    pooled.remove(-15);
+    ASSERT_FALSE(pooled.contains(-15));
+    ASSERT_EQ(int_values.size() - 1, pooled.size());
+
+    auto inordered = pooled.in_order();
+    auto expected = {-10, -5, 5, 8, 10, 15, 20, 25, 30};
+    auto i = 0u;
+    for (auto& value : expected) {
+        ASSERT_EQ(value, inordered[i]);
+        ++i;
+    }
+}
+
+/**
+ * Testa a árvore com nodos alocados em arena.
+ */
+TEST_F(AVLTreeTest, ArenaAllocator) {
+    {
+        structures::AVLTree<int, structures::ArenaAllocator> arena{};
+        multiple_insertion(arena, int_values);
+        contains_all(arena, int_values);
+        arena.remove(-15);
+        ASSERT_FALSE(arena.contains(-15));
+    }
+
+    {
+        structures::AVLTree<std::string, structures::ArenaAllocator> arena{};
+        multiple_insertion(arena, string_values);
+        contains_all(arena, string_values);
+    }
+}
+
+/**
+ * Testa a destruição de uma árvore grande (sem recursão).
+ */
+TEST_F(AVLTreeTest, LargeTeardown) {
+    structures::AVLTree<int> *large = new structures::AVLTree<int>();
+    auto value = 7;
+    for (auto i = 0; i < 2000; ++i) {
+        value = (value * 37 + 11) % 10007;
+        large->insert(value);
+    }
+    ASSERT_TRUE(large->contains(value));
+    delete large;
+}
+
+/**
+ * Testa operacoes na arvore vazia e com dados repetidos ou ausentes.
+ */
+TEST_F(AVLTreeTest, EmptyAndDuplicates) {
+    ASSERT_FALSE(int_list.contains(1));
+    int_list.remove(1);
+    ASSERT_TRUE(int_list.empty());
+    ASSERT_EQ(0u, int_list.in_order().size());
+
+    int_list.insert(1);
+    int_list.insert(1);
+    ASSERT_EQ(1u, int_list.size());
+    int_list.remove(2);
+    ASSERT_EQ(1u, int_list.size());
+    int_list.remove(1);
+    ASSERT_TRUE(int_list.empty());
+}
+
+/**
+ * Testa se insercoes em ordem mantem a arvore balanceada.
+ */
+TEST_F(AVLTreeTest, SortedInsertionIsBalanced) {
+    for (auto i = 1; i < 1024; ++i) {
+        int_list.insert(i);
+    }
+    /// 2^10 - 1 chaves em ordem formam uma arvore perfeita
+    auto preordered = int_list.pre_order();
+    ASSERT_EQ(512, preordered[0]);
+    ASSERT_EQ(256, preordered[1]);
+
+    for (auto i = 1; i < 512; ++i) {
+        int_list.remove(i);
+    }
+    ASSERT_EQ(512u, int_list.size());
+    ASSERT_EQ(512, int_list.in_order()[0]);
+
+    for (auto i = 0; i < 100000; ++i) {
+        dummy_list.insert(Dummy{static_cast<double>(i)});
+    }
+    ASSERT_TRUE(dummy_list.contains(Dummy{99999.}));
+}
+
+/**
+ * Compara a arvore com std::set em insercoes e remocoes aleatorias.
+ */
+TEST_F(AVLTreeTest, MatchesReference) {
+    std::set<int> reference;
+    for (auto i = 0; i < 20000; ++i) {
+        auto value = std::rand() % 1000;
+        if (std::rand() % 2 == 0) {
+            int_list.insert(value);
+            reference.insert(value);
+        } else {
+            int_list.remove(value);
+            reference.erase(value);
+        }
+        ASSERT_EQ(reference.size(), int_list.size());
+    }
+    auto inordered = int_list.in_order();
+    auto i = 0u;
+    for (auto value : reference) {
+        ASSERT_EQ(value, inordered[i++]);
+    }
+}
+
+/**
+ * Testa o retorno da insercao (dado novo ou repetido).
+ */
+TEST_F(AVLTreeTest, InsertReportsPresence) {
+    for (auto& value : int_values) {
+        ASSERT_TRUE(int_list.insert(value));
+    }
+    for (auto& value : int_values) {
+        ASSERT_FALSE(int_list.insert(value));
+    }
+    ASSERT_EQ(int_values.size(), int_list.size());
+}
+
+/**
+ * Testa try_emplace e insert_or_assign.
+ */
+TEST_F(AVLTreeTest, TryEmplaceAndInsertOrAssign) {
+    auto result = string_list.try_emplace(3u, 'a');
+    ASSERT_TRUE(result.second);
+    ASSERT_EQ("aaa", *result.first);
+    result = string_list.try_emplace("aaa");
+    ASSERT_FALSE(result.second);
+    ASSERT_EQ("aaa", *result.first);
+    ASSERT_EQ(1u, string_list.size());
+
+    for (auto i = 0; i < 100; ++i) {
+        auto inserted = int_list.try_emplace(i);
+        ASSERT_TRUE(inserted.second);
+        ASSERT_EQ(i, *inserted.first);
+        ASSERT_TRUE(inserted.first == int_list.find(i));
+    }
+
+    /// Dados equivalentes (mesmo valor) sao substituidos
+    auto assigned = dummy_list.insert_or_assign(Dummy{1.});
+    ASSERT_TRUE(assigned.second);
+    assigned = dummy_list.insert_or_assign(Dummy{1.});
+    ASSERT_FALSE(assigned.second);
+    ASSERT_EQ(Dummy{1.}, *assigned.first);
+    ASSERT_EQ(1u, dummy_list.size());
+}
+
+/**
+ * Testa find e a iteracao em ordem nos dois sentidos.
+ */
+TEST_F(AVLTreeTest, FindAndIterate) {
+    ASSERT_TRUE(int_list.begin() == int_list.end());
+    ASSERT_TRUE(int_list.find(1) == int_list.end());
+    multiple_insertion(int_list, int_values);
+
+    auto sorted = int_values;
+    std::sort(sorted.begin(), sorted.end());
+    auto i = 0u;
+    for (auto it = int_list.begin(); it != int_list.end(); ++it) {
+        ASSERT_EQ(sorted[i++], *it);
+    }
+    ASSERT_EQ(sorted.size(), i);
+
+    auto it = int_list.end();
+    while (i > 0) {
+        ASSERT_EQ(sorted[--i], *--it);
+    }
+    ASSERT_TRUE(it == int_list.begin());
+
+    it = int_list.find(15);
+    ASSERT_EQ(15, *it);
+    ASSERT_EQ(20, *++it);
+    ASSERT_EQ(10, *std::prev(int_list.find(15)));
+    ASSERT_TRUE(int_list.find(3) == int_list.end());
+}
+
+/**
+ * Testa os percursos por visitante contra as listas geradas.
+ */
+TEST_F(AVLTreeTest, Visitors) {
+    multiple_insertion(int_list, int_values);
+
+    std::vector<int> visited;
+    auto collect = [&visited](int value) { visited.push_back(value); };
+    auto check = [&visited](const structures::ArrayList<int>& expected) {
+        ASSERT_EQ(expected.size(), visited.size());
+        for (auto i = 0u; i < visited.size(); ++i) {
+            ASSERT_EQ(expected[i], visited[i]);
+        }
+        visited.clear();
+    };
+
+    int_list.visit_pre_order(collect);
+    check(int_list.pre_order());
+    int_list.visit_in_order(collect);
+    check(int_list.in_order());
+    int_list.visit_post_order(collect);
+    check(int_list.post_order());
+}
+
+/**
+ * Testa a navegacao ordenada.
+ */
+TEST_F(AVLTreeTest, OrderedNavigation) {
+    ASSERT_THROW(int_list.min(), std::out_of_range);
+    ASSERT_THROW(int_list.max(), std::out_of_range);
+    ASSERT_TRUE(int_list.lower_bound(0) == int_list.end());
+    ASSERT_TRUE(int_list.floor(0) == int_list.end());
+    ASSERT_TRUE(int_list.range(0, 10).empty());
+    multiple_insertion(int_list, int_values);
+
+    ASSERT_EQ(-15, int_list.min());
+    ASSERT_EQ(30, int_list.max());
+    ASSERT_EQ(15, *int_list.lower_bound(15));
+    ASSERT_EQ(15, *int_list.lower_bound(11));
+    ASSERT_EQ(20, *int_list.upper_bound(15));
+    ASSERT_EQ(15, *int_list.floor(15));
+    ASSERT_EQ(10, *int_list.floor(14));
+    ASSERT_EQ(15, *int_list.ceiling(14));
+    ASSERT_TRUE(int_list.lower_bound(31) == int_list.end());
+    ASSERT_TRUE(int_list.upper_bound(30) == int_list.end());
+    ASSERT_TRUE(int_list.floor(-16) == int_list.end());
+    ASSERT_TRUE(int_list.lower_bound(-100) == int_list.begin());
+    ASSERT_EQ(10, *--int_list.lower_bound(11));
+    ASSERT_EQ(30, *--int_list.upper_bound(100));
+
+    std::vector<int> in_range;
+    for (auto& value : int_list.range(-5, 15)) {
+        in_range.push_back(value);
+    }
+    ASSERT_EQ((std::vector<int>{-5, 5, 8, 10, 15}), in_range);
+    ASSERT_TRUE(int_list.range(16, 19).empty());
+    ASSERT_TRUE(int_list.range(15, -5).empty());
+}
+
+/**
+ * Compara a navegacao ordenada com std::set, em dados aleatorios.
+ */
+TEST_F(AVLTreeTest, NavigationMatchesReference) {
+    std::set<int> reference;
+    std::srand(11);
+    for (auto i = 0; i < 2000; ++i) {
+        auto value = std::rand() % 5000;
+        int_list.insert(value);
+        reference.insert(value);
+    }
+
+    for (auto probe = -1; probe <= 5001; probe += 7) {
+        auto lower = reference.lower_bound(probe);
+        auto it = int_list.lower_bound(probe);
+        if (lower == reference.end()) {
+            ASSERT_TRUE(it == int_list.end());
+        } else {
+            ASSERT_EQ(*lower, *it);
+        }
+
+        auto upper = reference.upper_bound(probe);
+        it = int_list.floor(probe);
+        if (upper == reference.begin()) {
+            ASSERT_TRUE(it == int_list.end());
+        } else {
+            ASSERT_EQ(*std::prev(upper), *it);
+        }
+
+        auto hi = probe + 100;
+        auto expected = reference.lower_bound(probe);
+        for (auto& value : int_list.range(probe, hi)) {
+            ASSERT_EQ(*expected++, value);
+        }
+        ASSERT_TRUE(expected == reference.upper_bound(hi));
+    }
+}
+
+/**
+ * Testa a construcao a partir de dados ordenados.
+ */
+TEST_F(AVLTreeTest, FromSorted) {
+    std::vector<int> sorted;
+    for (auto i = 1; i < 1024; ++i) {
+        sorted.push_back(i);
+    }
+    auto tree = structures::AVLTree<int>::from_sorted(sorted.begin(),
+                                                      sorted.end());
+    ASSERT_EQ(1023u, tree.size());
+    auto preordered = tree.pre_order();
+    ASSERT_EQ(512, preordered[0]);
+    ASSERT_EQ(256, preordered[1]);
+
+    /// Alturas corretas: continuar inserindo em ordem da a mesma arvore
+    /// perfeita que inserir tudo em ordem
+    for (auto i = 1024; i < 2048; ++i) {
+        tree.insert(i);
+    }
+    ASSERT_EQ(1024, tree.pre_order()[0]);
+
+    auto empty = structures::AVLTree<int>::from_sorted(sorted.end(),
+                                                       sorted.end());
+    ASSERT_TRUE(empty.empty());
+
+    auto repeated = std::vector<int>{1, 1, 2, 3, 3, 3, 4};
+    auto ranked = structures::RankedAVLTree<int>::from_sorted(
+        repeated.begin(), repeated.end());
+    ASSERT_EQ(4u, ranked.size());
+    ASSERT_EQ(3, ranked.select(2));
+    ASSERT_EQ(2u, ranked.rank(3));
+
+    auto unsorted = std::vector<std::string>{"a", "c", "b"};
+    ASSERT_THROW(structures::AVLTree<std::string>::from_sorted(
+                     unsorted.begin(), unsorted.end()),
+                 std::invalid_argument);
+}
+
+/**
+ * Testa copia, movimento e atribuicao.
+ */
+TEST_F(AVLTreeTest, CopyAndMove) {
+    multiple_insertion(string_list, string_values);
+    auto copy = string_list;
+    ASSERT_EQ(string_list.size(), copy.size());
+    copy.remove("AAA");
+    ASSERT_TRUE(string_list.contains("AAA"));
+    ASSERT_FALSE(copy.contains("AAA"));
+
+    auto moved = std::move(copy);
+    ASSERT_TRUE(copy.empty());
+    ASSERT_EQ(string_values.size() - 1, moved.size());
+
+    copy = string_list;
+    ASSERT_EQ(string_list.size(), copy.size());
+    copy.clear();
+    ASSERT_TRUE(copy.empty());
+    ASSERT_TRUE(copy.begin() == copy.end());
+}
+
+/**
+ * Testa a uniao de arvores, copiando ou reaproveitando os nodos.
+ */
+TEST_F(AVLTreeTest, Merge) {
+    std::set<int> reference;
+    structures::RankedAVLTree<int, structures::PoolAllocator> a{}, b{};
+    std::srand(5);
+    for (auto i = 0; i < 1000; ++i) {
+        auto value = std::rand() % 1500;
+        a.insert(value);
+        reference.insert(value);
+        value = std::rand() % 1500;
+        b.insert(value);
+        reference.insert(value);
+    }
+
+    auto c = a;  // copia compartilha o pool
+    c.merge(b);
+    ASSERT_EQ(reference.size(), c.size());
+    ASSERT_TRUE(std::equal(reference.begin(), reference.end(), c.begin()));
+    ASSERT_FALSE(b.empty());
+
+    a.merge(std::move(b));  // mesmo pool: religa os nodos
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(reference.size(), a.size());
+    ASSERT_TRUE(std::equal(reference.begin(), reference.end(), a.begin()));
+    auto k = 0u;
+    for (auto& value : reference) {
+        ASSERT_EQ(value, a.select(k++));
+    }
+
+    structures::RankedAVLTree<int, structures::PoolAllocator> other{};
+    other.insert(-1);
+    other.insert(5000);
+    a.merge(std::move(other));  // outro pool: copia
+    ASSERT_TRUE(other.empty());
+    ASSERT_EQ(reference.size() + 2, a.size());
+    ASSERT_EQ(-1, a.min());
+    ASSERT_EQ(5000, a.max());
+
+    /// Continua balanceada: insercoes e remocoes seguem corretas
+    for (auto i = 0; i < 1500; i += 2) {
+        a.remove(i);
+        reference.erase(i);
+    }
+    reference.insert(-1);
+    reference.insert(5000);
+    ASSERT_TRUE(std::equal(reference.begin(), reference.end(), a.begin()));
+    a.merge(a);
+    ASSERT_EQ(reference.size(), a.size());
+}
+
+/**
+ * Testa split e join.
+ */
+TEST_F(AVLTreeTest, SplitAndJoin) {
+    multiple_insertion(int_list, int_values);
+    structures::AVLTree<int> less{}, greater{};
+    ASSERT_TRUE(int_list.split(10, less, greater));
+    ASSERT_TRUE(int_list.empty());
+    ASSERT_EQ(5u, less.size());
+    ASSERT_EQ(4u, greater.size());
+    ASSERT_EQ(8, less.max());
+    ASSERT_EQ(15, greater.min());
+
+    ASSERT_THROW(less.join(9, std::move(less)), std::invalid_argument);
+    ASSERT_THROW(less.join(16, std::move(greater)), std::invalid_argument);
+    less.join(9, std::move(greater));
+    ASSERT_TRUE(greater.empty());
+    ASSERT_EQ(10u, less.size());
+    ASSERT_FALSE(less.contains(10));
+    ASSERT_TRUE(less.contains(9));
+
+    ASSERT_FALSE(less.split(12, int_list, greater));
+    ASSERT_EQ(6u, int_list.size());
+    ASSERT_EQ(4u, greater.size());
+    ASSERT_THROW(int_list.split(0, less, less), std::invalid_argument);
+
+    structures::RankedAVLTree<int> ranked{}, low{}, high{};
+    for (auto i = 0; i < 1000; ++i) {
+        ranked.insert(i);
+    }
+    ASSERT_TRUE(ranked.split(300, low, high));
+    ASSERT_EQ(300u, low.size());
+    ASSERT_EQ(699u, high.size());
+    ASSERT_EQ(301, high.select(0));
+    high.join(1000, std::move(ranked));  // ranked ficou vazia
+    ASSERT_EQ(1000, high.max());
+    low.join(300, std::move(high));
+    ASSERT_EQ(1001u, low.size());
+    for (auto i = 0u; i <= 1000; ++i) {
+        ASSERT_EQ(static_cast<int>(i), low.select(i));
+    }
+}
+
+/**
+ * Compara uniao, interseccao e diferenca com std::set, com arvores grandes
+ * o bastante para a recursao paralela.
+ */
+TEST_F(AVLTreeTest, SetOperations) {
+    std::srand(17);
+    for (auto n : {0, 1, 50, 200000}) {
+        std::set<int> set_a, set_b;
+        structures::RankedAVLTree<int> a{}, b{};
+        for (auto i = 0; i < n; ++i) {
+            auto value = std::rand() % (2 * n);
+            a.insert(value);
+            set_a.insert(value);
+            value = std::rand() % (2 * n);
+            b.insert(value);
+            set_b.insert(value);
+        }
+
+        std::vector<int> expected;
+        std::set_union(set_a.begin(), set_a.end(), set_b.begin(), set_b.end(),
+                       std::back_inserter(expected));
+        auto u = a, other = b;
+        u.merge(std::move(other));
+        ASSERT_TRUE(other.empty());
+        ASSERT_EQ(expected.size(), u.size());
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), u.begin()));
+
+        expected.clear();
+        std::set_intersection(set_a.begin(), set_a.end(), set_b.begin(),
+                              set_b.end(), std::back_inserter(expected));
+        auto i = a;
+        other = b;
+        i.intersect(std::move(other));
+        ASSERT_EQ(expected.size(), i.size());
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), i.begin()));
+        if (!expected.empty()) {
+            ASSERT_EQ(expected.back(), i.select(i.size() - 1));
+        }
+
+        expected.clear();
+        std::set_difference(set_a.begin(), set_a.end(), set_b.begin(),
+                            set_b.end(), std::back_inserter(expected));
+        a.subtract(std::move(b));
+        ASSERT_TRUE(b.empty());
+        ASSERT_EQ(expected.size(), a.size());
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), a.begin()));
+    }
+}
+
+/**
+ * Testa as operacoes de conjunto entre pools diferentes (copia os dados).
+ */
+TEST_F(AVLTreeTest, SetOperationsAcrossPools) {
+    structures::AVLTree<std::string, structures::PoolAllocator> a{}, b{};
+    multiple_insertion(a, string_values);
+    b.insert("AAA");
+    b.insert("ZZZ");
+    a.merge(std::move(b));
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(string_values.size() + 1, a.size());
+
+    b.insert("ZZZ");
+    b.insert("123");
+    b.insert("CCC");
+    a.intersect(std::move(b));
+    ASSERT_EQ(2u, a.size());
+    ASSERT_EQ("123", a.min());
+    ASSERT_EQ("ZZZ", a.max());
+
+    b.insert("ZZZ");
+    a.subtract(std::move(b));
+    ASSERT_EQ(1u, a.size());
+    a.subtract(std::move(a));
+    ASSERT_TRUE(a.empty());
+}
+
+/**
+ * Testa a copia congelada (layout de Eytzinger).
+ */
+TEST_F(AVLTreeTest, Freeze) {
+    auto empty = int_list.freeze();
+    ASSERT_TRUE(empty.empty());
+    ASSERT_FALSE(empty.contains(0));
+    ASSERT_EQ(nullptr, empty.lower_bound(0));
+
+    multiple_insertion(string_list, string_values);
+    auto strings = string_list.freeze();
+    ASSERT_EQ(string_values.size(), strings.size());
+    for (auto& value : string_values) {
+        ASSERT_TRUE(strings.contains(value));
+    }
+    ASSERT_FALSE(strings.contains("CCC"));
+    ASSERT_EQ("Goodbye, World!", *strings.lower_bound("CCC"));
+    ASSERT_EQ(nullptr, strings.lower_bound("ZZZ"));
+
+    /// Todos os formatos de arvore implicita ate 130 nos
+    for (auto n = 1; n <= 130; ++n) {
+        int_list.insert(2 * n);
+        auto frozen = int_list.freeze();
+        auto moved = std::move(frozen);
+        ASSERT_EQ(static_cast<std::size_t>(n), moved.size());
+        for (auto probe = 0; probe <= 2 * n + 1; ++probe) {
+            ASSERT_EQ(probe % 2 == 0 && probe > 0, moved.contains(probe));
+            auto lower = moved.lower_bound(probe);
+            if (probe > 2 * n) {
+                ASSERT_EQ(nullptr, lower);
+            } else {
+                ASSERT_EQ(std::max(2, probe + probe % 2), *lower);
+            }
+        }
+    }
+}
+
+/**
+ * Testa as consultas por posto.
+ */
+TEST_F(AVLTreeTest, RankAndSelect) {
+    structures::RankedAVLTree<int> ranked{};
+    ASSERT_THROW(ranked.select(0), std::out_of_range);
+    ASSERT_EQ(0u, ranked.rank(5));
+    multiple_insertion(ranked, int_values);
+
+    auto sorted = int_values;
+    std::sort(sorted.begin(), sorted.end());
+    for (auto i = 0u; i < sorted.size(); ++i) {
+        ASSERT_EQ(sorted[i], ranked.select(i));
+        ASSERT_EQ(i, ranked.rank(sorted[i]));
+    }
+    ASSERT_THROW(ranked.select(sorted.size()), std::out_of_range);
+    ASSERT_EQ(3u, ranked.rank(0));  // -15, -10, -5
+    ASSERT_EQ(10u, ranked.rank(100));
+    ASSERT_EQ(5u, ranked.count_range(-5, 15));  // -5, 5, 8, 10, 15
+    ASSERT_EQ(4u, ranked.count_range(-4, 16));
+    ASSERT_EQ(0u, ranked.count_range(16, 19));
+    ASSERT_EQ(0u, ranked.count_range(15, -5));
+}
+
+/**
+ * Compara as consultas por posto com std::set em operacoes aleatorias.
+ */
+TEST_F(AVLTreeTest, RankMatchesReference) {
+    structures::RankedAVLTree<int, structures::PoolAllocator> ranked{};
+    std::set<int> reference;
+    for (auto i = 0; i < 5000; ++i) {
+        auto value = std::rand() % 500;
+        if (std::rand() % 3 != 0) {
+            ASSERT_EQ(reference.insert(value).second, ranked.insert(value));
+        } else {
+            ranked.remove(value);
+            reference.erase(value);
+        }
+        auto probe = std::rand() % 500;
+        auto rank = std::distance(reference.begin(),
+                                  reference.lower_bound(probe));
+        ASSERT_EQ(static_cast<std::size_t>(rank), ranked.rank(probe));
+        if (!reference.empty()) {
+            auto k = static_cast<std::size_t>(std::rand()) % reference.size();
+            ASSERT_EQ(*std::next(reference.begin(), k), ranked.select(k));
+        }
+    }
+}
+
 int main(int argc, char* argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -1,14 +1,26 @@
 /// Copyright [2018] <Joao Fellipe Uller>
 #ifndef BINARY_TREE_HPP
 #define BINARY_TREE_HPP
+
+#include <iterator>
+#include <type_traits>
 #include "array_list.hpp"
+#include "node_allocator.hpp"
 
 namespace structures {
 
-template <typename T>
+template <typename T, template<typename> class Allocator = NewAllocator>
 /// Implementa uma arvore binaria
 class BinaryTree {
+    struct Node;
+    class Iterator;
+
  public:
+    /// Iterador em ordem; os dados sao constantes (mudar um dado poderia
+    /// desordenar a arvore)
+    typedef Iterator iterator;
+    typedef Iterator const_iterator;
+
     /// Destrutor da arvore
     ~BinaryTree();
 
@@ -27,6 +39,24 @@ class BinaryTree {
     /// Retorna o tamanho da arvore
     std::size_t size() const;
 
+    /// Iterador para o menor elemento
+    iterator begin() const;
+
+    /// Iterador para depois do maior elemento
+    iterator end() const;
+
+    /// Percursos sem copiar a arvore: chamam visit(dado) para cada dado, na
+    /// ordem do percurso. A arvore nao e' balanceada, entao a pilha e' uma
+    /// lista crescente (sem recursao, qualquer que seja a altura)
+    template<typename Visitor>
+    void visit_pre_order(Visitor&& visit) const;
+
+    template<typename Visitor>
+    void visit_in_order(Visitor&& visit) const;
+
+    template<typename Visitor>
+    void visit_post_order(Visitor&& visit) const;
+
     /// Retorna a arvore percorrida em pre-ordem
     ArrayList<T> pre_order() const;
 
@@ -46,41 +76,41 @@ class BinaryTree {
             data_ = data;
         }
 
-        void insert(const T& data) {
+        void insert(const T& data, Allocator<Node>& allocator) {
             if (data < data_) {
                 if (left_ == nullptr)
-                    left_ = new Node(data);
+                    left_ = allocator.create(data);
                 else
-                    left_->insert(data);
+                    left_->insert(data, allocator);
             } else {
                 if (right_ == nullptr)
-                    right_ = new Node(data);
+                    right_ = allocator.create(data);
                 else
-                    right_->insert(data);
+                    right_->insert(data, allocator);
             }
         }
 
-        bool remove(const T& data) {
+        bool remove(const T& data, Allocator<Node>& allocator) {
             if ((data > data_) && (right_ != nullptr)) {
-                if (!right_->remove(data)) {
-                    delete right_;
+                if (!right_->remove(data, allocator)) {
+                    allocator.destroy(right_);
                     right_ = nullptr;
                 }
             } else if ((data < data_) && (left_ != nullptr)) {
-                if(!left_->remove(data)) {
-                    delete left_;
+                if(!left_->remove(data, allocator)) {
+                    allocator.destroy(left_);
                     left_ = nullptr;
                 }
             } else {
                 if ((right_ != nullptr) && (left_ != nullptr)) {
                     data_ = right_->minimun();
-                    right_->remove(data_);
+                    right_->remove(data_, allocator);
                 } else if (right_ != nullptr) {
                     data_ = right_->data_;
-                    right_->remove(data_);
+                    right_->remove(data_, allocator);
                 } else if (left_ != nullptr) {
                     data_ = left_->data_;
-                    left_->remove(data_);
+                    left_->remove(data_, allocator);
                 } else {
                     return false;
                 }
@@ -102,30 +132,6 @@ class BinaryTree {
             }
         }
 
-        void pre_order(ArrayList<T>& v) const {
-            v.push_back(data_);
-            if (left_ != nullptr)
-                left_->pre_order(v);
-            if (right_ != nullptr)
-                right_->pre_order(v);
-        }
-
-        void in_order(ArrayList<T>& v) const {
-            if (left_ != nullptr)
-                left_->in_order(v);
-            v.push_back(data_);
-            if (right_ != nullptr)
-                right_->in_order(v);
-        }
-
-        void post_order(ArrayList<T>& v) const {
-            if (left_ != nullptr)
-                left_->post_order(v);
-            if (right_ != nullptr)
-                right_->post_order(v);
-            v.push_back(data_);
-        }
-
         T minimun() {
             if (left_ == nullptr)
                 return data_;
@@ -135,67 +141,185 @@ class BinaryTree {
 
     };  // struct Node
 
-    Node* root_;
-    std::size_t size_;
+    /// Pilha de nodos: lista crescente que nao aloca enquanto vazia
+    typedef ArrayList<const Node*> Stack;
+
+    /// Iterador bidirecional: guarda o caminho da raiz ate o no' corrente
+    /// (nenhum no' guarda o pai), e avanca em O(1) amortizado
+    class Iterator {
+     public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        Iterator() = default;
+
+        reference operator*() const {
+            return path_[path_.size() - 1]->data_;
+        }
+
+        pointer operator->() const {
+            return &path_[path_.size() - 1]->data_;
+        }
+
+        Iterator& operator++() {
+            const Node *node = path_[path_.size() - 1];
+            if (node->right_ != nullptr) {  // menor da subarvore direita
+                path_.push_back(node->right_);
+                leftmost();
+            } else {  // sobe ate vir de um filho esquerdo
+                const Node *child;
+                do {
+                    child = path_.pop_back();
+                } while (!path_.empty() &&
+                         (path_[path_.size() - 1]->left_ != child));
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old{*this};
+            ++*this;
+            return old;
+        }
+
+        Iterator& operator--() {
+            if (path_.empty()) {  // end(): maior elemento
+                path_.push_back(tree_->root_);
+                rightmost();
+                return *this;
+            }
+
+            const Node *node = path_[path_.size() - 1];
+            if (node->left_ != nullptr) {  // maior da subarvore esquerda
+                path_.push_back(node->left_);
+                rightmost();
+            } else {  // sobe ate vir de um filho direito
+                const Node *child;
+                do {
+                    child = path_.pop_back();
+                } while (!path_.empty() &&
+                         (path_[path_.size() - 1]->right_ != child));
+            }
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator old{*this};
+            --*this;
+            return old;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            return a.node() == b.node();
+        }
+
+        friend bool operator!=(const Iterator& a, const Iterator& b) {
+            return a.node() != b.node();
+        }
+
+     private:
+        friend class BinaryTree;
+
+        explicit Iterator(const BinaryTree* tree):
+            tree_{tree}
+        {}
+
+        const Node* node() const {
+            return path_.empty() ? nullptr : path_[path_.size() - 1];
+        }
+
+        void leftmost() {  // desce a esquerda a partir do no' corrente
+            const Node *node = path_[path_.size() - 1];
+            while (node->left_ != nullptr) {
+                node = node->left_;
+                path_.push_back(node);
+            }
+        }
+
+        void rightmost() {  // desce a direita a partir do no' corrente
+            const Node *node = path_[path_.size() - 1];
+            while (node->right_ != nullptr) {
+                node = node->right_;
+                path_.push_back(node);
+            }
+        }
+
+        const BinaryTree* tree_{nullptr};
+        Stack path_{0u, DEFAULT_GROWTH};
+    };
+
+    Node* root_{nullptr};
+    std::size_t size_{0u};
+    Allocator<Node> allocator_;  // alocador de nodos
 };
 
 }  // namespace structures
 
 // IMPLEMENTACAO
 
-template <typename T>
-structures::BinaryTree<T>::~BinaryTree() {
-    while (size_ > 0) {
-        Node *aux = root_;
-        while ((aux->left_ != nullptr) || (aux->right_ != nullptr)) {
-            if (aux->left_ != nullptr)
-                aux = aux->left_;
-            else
-                aux = aux->right_;
+template <typename T, template<typename> class Allocator>
+structures::BinaryTree<T, Allocator>::~BinaryTree() {
+    /// Na arena, a memoria de todos os nodos e' liberada junto com o alocador
+    if (Allocator<Node>::bulk_release && std::is_trivially_destructible<T>::value)
+        return;
+
+    /// Desmontagem iterativa em O(n) e sem pilha: enquanto o no' corrente tem
+    /// filho esquerdo, rotaciona a direita; senao, libera-o e segue a direita
+    Node *node = root_;
+    while (node != nullptr) {
+        if (node->left_ != nullptr) {
+            Node *left = node->left_;
+            node->left_ = left->right_;
+            left->right_ = node;
+            node = left;
+        } else {
+            Node *right = node->right_;
+            allocator_.destroy(node);
+            node = right;
         }
-
-        aux->remove(aux->data_);
-        size_--;
     }
 }
 
-template <typename T>
-void structures::BinaryTree<T>::insert(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::BinaryTree<T, Allocator>::insert(const T& data) {
     if (empty()) {
-        root_ = new Node(data);
+        root_ = allocator_.create(data);
     } else if (!contains(data)) {
         if (data < root_->data_) {
             if (root_->left_ == nullptr)
-                root_->left_ = new Node(data);
+                root_->left_ = allocator_.create(data);
             else
-                root_->left_->insert(data);
+                root_->left_->insert(data, allocator_);
         } else {
             if (root_->right_ == nullptr)
-                root_->right_ = new Node(data);
+                root_->right_ = allocator_.create(data);
             else
-                root_->right_->insert(data);
+                root_->right_->insert(data, allocator_);
         }
     }
     size_++;
 }
 
-template <typename T>
-void structures::BinaryTree<T>::remove(const T& data) {
+template <typename T, template<typename> class Allocator>
+void structures::BinaryTree<T, Allocator>::remove(const T& data) {
     if (contains(data)) {
         if (root_->data_ == data) {
             if (root_->left_ == nullptr) {
                 if (root_->right_ == nullptr) {
-                    delete root_;
+                    allocator_.destroy(root_);
                     root_ = nullptr;
                 } else {
                     Node *aux = root_->right_;
-                    delete root_;
+                    allocator_.destroy(root_);
                     root_ = aux;
                 }
             } else {
                 if (root_->right_ == nullptr) {
                     Node *aux = root_->left_;
-                    delete root_;
+                    allocator_.destroy(root_);
                     root_ = aux;
                 } else {
                     T temp = root_->right_->minimun();
@@ -205,17 +329,17 @@ void structures::BinaryTree<T>::remove(const T& data) {
             }
         } else {
             if (data < root_->data_)
-                root_->left_->remove(data);
+                root_->left_->remove(data, allocator_);
             else
-                root_->right_->remove(data);
+                root_->right_->remove(data, allocator_);
         }
 
         size_--;
     }
 }
 
-template <typename T>
-bool structures::BinaryTree<T>::contains(const T& data) const {
+template <typename T, template<typename> class Allocator>
+bool structures::BinaryTree<T, Allocator>::contains(const T& data) const {
     if (root_->data_ == data) {
         return true;
     } else {
@@ -228,53 +352,102 @@ bool structures::BinaryTree<T>::contains(const T& data) const {
     }
 }
 
-template <typename T>
-bool structures::BinaryTree<T>::empty() const {
+template <typename T, template<typename> class Allocator>
+bool structures::BinaryTree<T, Allocator>::empty() const {
     return size_ == 0;
 }
 
-template <typename T>
-std::size_t structures::BinaryTree<T>::size() const {
+template <typename T, template<typename> class Allocator>
+std::size_t structures::BinaryTree<T, Allocator>::size() const {
     return size_;
 }
 
-template <typename T>
-structures::ArrayList<T> structures::BinaryTree<T>::pre_order() const {
-    ArrayList<T> *list = new ArrayList<T>(size_);
+template <typename T, template<typename> class Allocator>
+typename structures::BinaryTree<T, Allocator>::iterator
+structures::BinaryTree<T, Allocator>::begin() const {
+    iterator it{this};
+    if (root_ != nullptr) {
+        it.path_.push_back(root_);
+        it.leftmost();
+    }
 
-    list->push_back(root_->data_);
-    if (root_->left_ != nullptr)
-        root_->left_->pre_order(*list);
-    if (root_->right_ != nullptr)
-        root_->right_->pre_order(*list);
+    return it;
+}
 
-    return *list;
+template <typename T, template<typename> class Allocator>
+typename structures::BinaryTree<T, Allocator>::iterator
+structures::BinaryTree<T, Allocator>::end() const {
+    return iterator{this};
 }
 
-template <typename T>
-structures::ArrayList<T> structures::BinaryTree<T>::in_order() const {
-    ArrayList<T> *list = new ArrayList<T>(size_);
+template <typename T, template<typename> class Allocator>
+template<typename Visitor>
+void structures::BinaryTree<T, Allocator>::visit_pre_order(
+    Visitor&& visit) const {
+    Stack pending{0u, DEFAULT_GROWTH};  // subarvores direitas pendentes
+    const Node *node = root_;
+    while ((node != nullptr) || !pending.empty()) {
+        if (node == nullptr)
+            node = pending.pop_back();
+
+        visit(node->data_);
+        if (node->right_ != nullptr)
+            pending.push_back(node->right_);
+        node = node->left_;
+    }
+}
 
-    if (root_->left_ != nullptr)
-        root_->left_->in_order(*list);
-    list->push_back(root_->data_);
-    if (root_->right_ != nullptr)
-        root_->right_->in_order(*list);
+template <typename T, template<typename> class Allocator>
+template<typename Visitor>
+void structures::BinaryTree<T, Allocator>::visit_in_order(
+    Visitor&& visit) const {
+    for (const_iterator it = begin(), last = end(); it != last; ++it)
+        visit(*it);
+}
 
-    return *list;
+template <typename T, template<typename> class Allocator>
+template<typename Visitor>
+void structures::BinaryTree<T, Allocator>::visit_post_order(
+    Visitor&& visit) const {
+    Stack path{0u, DEFAULT_GROWTH};  // caminho ate o no' corrente
+    const Node *node = root_;
+    const Node *last = nullptr;  // ultimo no' visitado
+    while ((node != nullptr) || !path.empty()) {
+        if (node != nullptr) {
+            path.push_back(node);
+            node = node->left_;
+        } else {
+            const Node *top = path[path.size() - 1];
+            if ((top->right_ != nullptr) && (top->right_ != last)) {
+                node = top->right_;
+            } else {
+                visit(top->data_);
+                last = top;
+                path.pop_back();
+            }
+        }
+    }
 }
 
-template <typename T>
-structures::ArrayList<T> structures::BinaryTree<T>::post_order() const {
-    ArrayList<T>* list = new ArrayList<T>(size_);
+template <typename T, template<typename> class Allocator>
+structures::ArrayList<T> structures::BinaryTree<T, Allocator>::pre_order() const {
+    ArrayList<T> list{size_};
+    visit_pre_order([&list](const T& data) { list.push_back(data); });
+    return list;
+}
 
-    if (root_->left_ != nullptr)
-        root_->left_->post_order(*list);
-    if (root_->right_ != nullptr)
-        root_->right_->post_order(*list);
-    list->push_back(root_->data_);
+template <typename T, template<typename> class Allocator>
+structures::ArrayList<T> structures::BinaryTree<T, Allocator>::in_order() const {
+    ArrayList<T> list{size_};
+    visit_in_order([&list](const T& data) { list.push_back(data); });
+    return list;
+}
 
-    return *list;
+template <typename T, template<typename> class Allocator>
+structures::ArrayList<T> structures::BinaryTree<T, Allocator>::post_order() const {
+    ArrayList<T> list{size_};
+    visit_post_order([&list](const T& data) { list.push_back(data); });
+    return list;
 }
 
 #endif
@@ -1,5 +1,8 @@
 // Copyright 2016 João Paulo Taylor Ienczak Zanette
+#include <algorithm>
+#include <iterator>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "binary_tree.hpp"
@@ -379,6 +382,133 @@ TEST_F(BinaryTreeTest, PostOrder) {
 }
 
 
+/**
+ * Testa a árvore com nodos alocados em pool.
+ */
+TEST_F(BinaryTreeTest, PoolAllocator) {
+    structures::BinaryTree<int, structures::PoolAllocator> pooled{};
+    multiple_insertion(pooled, int_values);
+    contains_all(pooled, int_values);
+
+    pooled.remove(-15);
+    ASSERT_FALSE(pooled.contains(-15));
+    ASSERT_EQ(int_values.size() - 1, pooled.size());
+
+    auto inordered = pooled.in_order();
+    auto expected = {-10, -5, 5, 8, 10, 15, 20, 25, 30};
+    auto i = 0u;
+    for (auto& value : expected) {
+        ASSERT_EQ(value, inordered[i]);
+        ++i;
+    }
+}
+
+/**
+ * Testa a árvore com nodos alocados em arena.
+ */
+TEST_F(BinaryTreeTest, ArenaAllocator) {
+    {
+        structures::BinaryTree<int, structures::ArenaAllocator> arena{};
+        multiple_insertion(arena, int_values);
+        contains_all(arena, int_values);
+        arena.remove(-15);
+        ASSERT_FALSE(arena.contains(-15));
+    }
+
+    {
+        structures::BinaryTree<std::string, structures::ArenaAllocator> arena{};
+        multiple_insertion(arena, string_values);
+        contains_all(arena, string_values);
+    }
+}
+
+/**
+ * Testa a destruição de uma árvore grande (sem recursão).
+ */
+TEST_F(BinaryTreeTest, LargeTeardown) {
+    structures::BinaryTree<int> *large = new structures::BinaryTree<int>();
+    auto value = 7;
+    for (auto i = 0; i < 2000; ++i) {
+        value = (value * 37 + 11) % 10007;
+        large->insert(value);
+    }
+    ASSERT_TRUE(large->contains(value));
+    delete large;
+}
+
+/**
+ * Testa a iteracao em ordem nos dois sentidos.
+ */
+TEST_F(BinaryTreeTest, Iterate) {
+    ASSERT_TRUE(int_list.begin() == int_list.end());
+    ASSERT_EQ(0u, int_list.in_order().size());
+    multiple_insertion(int_list, int_values);
+
+    auto sorted = int_values;
+    std::sort(sorted.begin(), sorted.end());
+    auto i = 0u;
+    for (auto& value : int_list) {
+        ASSERT_EQ(sorted[i++], value);
+    }
+    ASSERT_EQ(sorted.size(), i);
+
+    auto it = int_list.end();
+    while (i > 0) {
+        ASSERT_EQ(sorted[--i], *--it);
+    }
+    ASSERT_TRUE(it == int_list.begin());
+    ASSERT_EQ(30, *std::prev(int_list.end()));
+}
+
+/**
+ * Testa os percursos por visitante contra as listas geradas.
+ */
+TEST_F(BinaryTreeTest, Visitors) {
+    multiple_insertion(string_list, string_values);
+
+    auto check = [](const structures::ArrayList<std::string>& expected,
+                    const std::vector<std::string>& visited) {
+        ASSERT_EQ(expected.size(), visited.size());
+        for (auto i = 0u; i < visited.size(); ++i) {
+            ASSERT_EQ(expected[i], visited[i]);
+        }
+    };
+
+    std::vector<std::string> visited;
+    auto collect = [&visited](const std::string& s) { visited.push_back(s); };
+    string_list.visit_pre_order(collect);
+    check(string_list.pre_order(), visited);
+    visited.clear();
+    string_list.visit_in_order(collect);
+    check(string_list.in_order(), visited);
+    visited.clear();
+    string_list.visit_post_order(collect);
+    check(string_list.post_order(), visited);
+}
+
+/**
+ * Testa iteracao e percursos numa arvore degenerada (insercao ordenada).
+ */
+TEST_F(BinaryTreeTest, DegenerateTraversal) {
+    for (auto i = 0; i < 5000; ++i) {
+        int_list.insert(i);
+    }
+
+    auto expected = 0;
+    for (auto& value : int_list) {
+        ASSERT_EQ(expected++, value);
+    }
+    ASSERT_EQ(5000, expected);
+    ASSERT_EQ(4999, *--int_list.end());
+
+    auto post = int_list.post_order();
+    ASSERT_EQ(4999, post[0]);
+    ASSERT_EQ(0, post[4999]);
+    auto pre = int_list.pre_order();
+    ASSERT_EQ(0, pre[0]);
+    ASSERT_EQ(4999, pre[4999]);
+}
+
 int main(int argc, char* argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();